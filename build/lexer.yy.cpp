@@ -0,0 +1,40 @@
+// Development-only stand-in for reentrant flex output (flex unavailable in sandbox).
+#include "parser.tab.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <map>
+#include <cctype>
+struct StubScanner { FILE *in = nullptr; ParserState *extra = nullptr; };
+int yylex_init_extra(ParserState *extra, yyscan_t *scanner){ auto s=new StubScanner; s->extra=extra; *scanner=s; return 0; }
+ParserState *yyget_extra(yyscan_t scanner){ return ((StubScanner*)scanner)->extra; }
+void yyset_in(FILE *file, yyscan_t scanner){ ((StubScanner*)scanner)->in=file; }
+int yylex_destroy(yyscan_t scanner){ delete (StubScanner*)scanner; return 0; }
+#define yyin (((StubScanner*)yyscanner)->in)
+#define yylval (*yylval_param)
+#define peekc() ([&]{int c_=fgetc(yyin); if(c_!=EOF) ungetc(c_,yyin); return c_;}())
+int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner){
+  static const std::map<std::string,int> kw={{"auto",AUTO},{"break",BREAK},{"case",CASE},{"char",CHAR},{"const",CONST},{"continue",CONTINUE},{"default",DEFAULT},{"do",DO},{"double",DOUBLE},{"else",ELSE},{"enum",ENUM},{"extern",EXTERN},{"float",FLOAT},{"for",FOR},{"goto",GOTO},{"if",IF},{"int",INT},{"long",LONG},{"register",REGISTER},{"return",RETURN},{"short",SHORT},{"signed",SIGNED},{"sizeof",SIZEOF},{"static",STATIC},{"struct",STRUCT},{"switch",SWITCH},{"typedef",TYPEDEF},{"union",UNION},{"unsigned",UNSIGNED},{"void",VOID},{"volatile",VOLATILE},{"while",WHILE},{"__attribute__",ATTRIBUTE}};
+  int c;
+  for(;;){
+    c=fgetc(yyin); if(c==EOF) return 0;
+    if(isspace(c)) continue;
+    if(c=='/'&&peekc()=='*'){fgetc(yyin); int p=0; while((c=fgetc(yyin))!=EOF){ if(p=='*'&&c=='/') break; p=c;} continue;}
+    if(c=='/'&&peekc()=='/'){while((c=fgetc(yyin))!=EOF&&c!='\n'); continue;}
+    break;
+  }
+  if(isalpha(c)||c=='_'){std::string s(1,(char)c); while(isalnum(peekc())||peekc()=='_') s+=(char)fgetc(yyin);
+    auto it=kw.find(s); if(it!=kw.end()) return it->second; yylval.string=new std::string(s); return IDENTIFIER;}
+  if(isdigit(c)||(c=='.'&&isdigit(peekc()))){std::string s(1,(char)c); bool fl=(c=='.');
+    while(isalnum(peekc())||peekc()=='.'){int d=fgetc(yyin); if(d=='.'||((d=='e'||d=='E')&&s.find("0x")==std::string::npos)) fl=true; s+=(char)d;}
+    if(fl){yylval.number_float=strtod(s.c_str(),0); return FLOAT_CONSTANT;}
+    yylval.number_int=(int)strtol(s.c_str(),0,0); return INT_CONSTANT;}
+  if(c=='\''){int v=fgetc(yyin); if(v=='\\'){v=fgetc(yyin); if(v=='n')v='\n'; else if(v=='0') v=0;} fgetc(yyin); yylval.number_int=v; return INT_CONSTANT;}
+  if(c=='"'){while((c=fgetc(yyin))!=EOF&&c!='"'){if(c=='\\')fgetc(yyin);} return STRING_LITERAL;}
+  struct {const char*s;int t;} ops[]={{"...",ELLIPSIS},{">>=",RIGHT_ASSIGN},{"<<=",LEFT_ASSIGN},{"+=",ADD_ASSIGN},{"-=",SUB_ASSIGN},{"*=",MUL_ASSIGN},{"/=",DIV_ASSIGN},{"%=",MOD_ASSIGN},{"&=",AND_ASSIGN},{"^=",XOR_ASSIGN},{"|=",OR_ASSIGN},{">>",RIGHT_OP},{"<<",LEFT_OP},{"++",INC_OP},{"--",DEC_OP},{"->",PTR_OP},{"&&",AND_OP},{"||",OR_OP},{"<=",LE_OP},{">=",GE_OP},{"==",EQ_OP},{"!=",NE_OP}};
+  for(auto&o:ops){size_t n=strlen(o.s); if(o.s[0]!=c) continue; char buf[4]={(char)c,0,0,0}; size_t k=1; bool ok=true;
+    for(;k<n;k++){int d=fgetc(yyin); if(d!=o.s[k]){ if(d!=EOF) ungetc(d,yyin); ok=false; break;} buf[k]=d;}
+    if(ok) return o.t;
+    for(size_t j=k-1;j>=1;j--){ungetc(buf[j],yyin);} }
+  return c;
+}
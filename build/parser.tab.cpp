@@ -0,0 +1,3105 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IDENTIFIER = 3,                 /* IDENTIFIER  */
+  YYSYMBOL_INT_CONSTANT = 4,               /* INT_CONSTANT  */
+  YYSYMBOL_FLOAT_CONSTANT = 5,             /* FLOAT_CONSTANT  */
+  YYSYMBOL_STRING_LITERAL = 6,             /* STRING_LITERAL  */
+  YYSYMBOL_PTR_OP = 7,                     /* PTR_OP  */
+  YYSYMBOL_INC_OP = 8,                     /* INC_OP  */
+  YYSYMBOL_DEC_OP = 9,                     /* DEC_OP  */
+  YYSYMBOL_LEFT_OP = 10,                   /* LEFT_OP  */
+  YYSYMBOL_RIGHT_OP = 11,                  /* RIGHT_OP  */
+  YYSYMBOL_LE_OP = 12,                     /* LE_OP  */
+  YYSYMBOL_GE_OP = 13,                     /* GE_OP  */
+  YYSYMBOL_EQ_OP = 14,                     /* EQ_OP  */
+  YYSYMBOL_NE_OP = 15,                     /* NE_OP  */
+  YYSYMBOL_AND_OP = 16,                    /* AND_OP  */
+  YYSYMBOL_OR_OP = 17,                     /* OR_OP  */
+  YYSYMBOL_MUL_ASSIGN = 18,                /* MUL_ASSIGN  */
+  YYSYMBOL_DIV_ASSIGN = 19,                /* DIV_ASSIGN  */
+  YYSYMBOL_MOD_ASSIGN = 20,                /* MOD_ASSIGN  */
+  YYSYMBOL_ADD_ASSIGN = 21,                /* ADD_ASSIGN  */
+  YYSYMBOL_SUB_ASSIGN = 22,                /* SUB_ASSIGN  */
+  YYSYMBOL_LEFT_ASSIGN = 23,               /* LEFT_ASSIGN  */
+  YYSYMBOL_RIGHT_ASSIGN = 24,              /* RIGHT_ASSIGN  */
+  YYSYMBOL_AND_ASSIGN = 25,                /* AND_ASSIGN  */
+  YYSYMBOL_XOR_ASSIGN = 26,                /* XOR_ASSIGN  */
+  YYSYMBOL_OR_ASSIGN = 27,                 /* OR_ASSIGN  */
+  YYSYMBOL_TYPE_NAME = 28,                 /* TYPE_NAME  */
+  YYSYMBOL_TYPEDEF = 29,                   /* TYPEDEF  */
+  YYSYMBOL_EXTERN = 30,                    /* EXTERN  */
+  YYSYMBOL_STATIC = 31,                    /* STATIC  */
+  YYSYMBOL_AUTO = 32,                      /* AUTO  */
+  YYSYMBOL_REGISTER = 33,                  /* REGISTER  */
+  YYSYMBOL_SIZEOF = 34,                    /* SIZEOF  */
+  YYSYMBOL_CHAR = 35,                      /* CHAR  */
+  YYSYMBOL_SHORT = 36,                     /* SHORT  */
+  YYSYMBOL_INT = 37,                       /* INT  */
+  YYSYMBOL_LONG = 38,                      /* LONG  */
+  YYSYMBOL_SIGNED = 39,                    /* SIGNED  */
+  YYSYMBOL_UNSIGNED = 40,                  /* UNSIGNED  */
+  YYSYMBOL_FLOAT = 41,                     /* FLOAT  */
+  YYSYMBOL_DOUBLE = 42,                    /* DOUBLE  */
+  YYSYMBOL_CONST = 43,                     /* CONST  */
+  YYSYMBOL_VOLATILE = 44,                  /* VOLATILE  */
+  YYSYMBOL_VOID = 45,                      /* VOID  */
+  YYSYMBOL_STRUCT = 46,                    /* STRUCT  */
+  YYSYMBOL_UNION = 47,                     /* UNION  */
+  YYSYMBOL_ENUM = 48,                      /* ENUM  */
+  YYSYMBOL_ELLIPSIS = 49,                  /* ELLIPSIS  */
+  YYSYMBOL_ATTRIBUTE = 50,                 /* ATTRIBUTE  */
+  YYSYMBOL_CASE = 51,                      /* CASE  */
+  YYSYMBOL_DEFAULT = 52,                   /* DEFAULT  */
+  YYSYMBOL_IF = 53,                        /* IF  */
+  YYSYMBOL_ELSE = 54,                      /* ELSE  */
+  YYSYMBOL_SWITCH = 55,                    /* SWITCH  */
+  YYSYMBOL_WHILE = 56,                     /* WHILE  */
+  YYSYMBOL_DO = 57,                        /* DO  */
+  YYSYMBOL_FOR = 58,                       /* FOR  */
+  YYSYMBOL_GOTO = 59,                      /* GOTO  */
+  YYSYMBOL_CONTINUE = 60,                  /* CONTINUE  */
+  YYSYMBOL_BREAK = 61,                     /* BREAK  */
+  YYSYMBOL_RETURN = 62,                    /* RETURN  */
+  YYSYMBOL_63_ = 63,                       /* ';'  */
+  YYSYMBOL_64_ = 64,                       /* '('  */
+  YYSYMBOL_65_ = 65,                       /* ')'  */
+  YYSYMBOL_66_ = 66,                       /* '['  */
+  YYSYMBOL_67_ = 67,                       /* ']'  */
+  YYSYMBOL_68_ = 68,                       /* '.'  */
+  YYSYMBOL_69_ = 69,                       /* ','  */
+  YYSYMBOL_70_ = 70,                       /* '&'  */
+  YYSYMBOL_71_ = 71,                       /* '*'  */
+  YYSYMBOL_72_ = 72,                       /* '+'  */
+  YYSYMBOL_73_ = 73,                       /* '-'  */
+  YYSYMBOL_74_ = 74,                       /* '~'  */
+  YYSYMBOL_75_ = 75,                       /* '!'  */
+  YYSYMBOL_76_ = 76,                       /* '/'  */
+  YYSYMBOL_77_ = 77,                       /* '%'  */
+  YYSYMBOL_78_ = 78,                       /* '<'  */
+  YYSYMBOL_79_ = 79,                       /* '>'  */
+  YYSYMBOL_80_ = 80,                       /* '^'  */
+  YYSYMBOL_81_ = 81,                       /* '|'  */
+  YYSYMBOL_82_ = 82,                       /* '?'  */
+  YYSYMBOL_83_ = 83,                       /* ':'  */
+  YYSYMBOL_84_ = 84,                       /* '='  */
+  YYSYMBOL_85_ = 85,                       /* '{'  */
+  YYSYMBOL_86_ = 86,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 87,                  /* $accept  */
+  YYSYMBOL_ROOT = 88,                      /* ROOT  */
+  YYSYMBOL_translation_unit = 89,          /* translation_unit  */
+  YYSYMBOL_external_declaration = 90,      /* external_declaration  */
+  YYSYMBOL_function_definition = 91,       /* function_definition  */
+  YYSYMBOL_attribute_specifier = 92,       /* attribute_specifier  */
+  YYSYMBOL_primary_expression = 93,        /* primary_expression  */
+  YYSYMBOL_postfix_expression = 94,        /* postfix_expression  */
+  YYSYMBOL_argument_expression_list = 95,  /* argument_expression_list  */
+  YYSYMBOL_unary_expression = 96,          /* unary_expression  */
+  YYSYMBOL_unary_operator = 97,            /* unary_operator  */
+  YYSYMBOL_cast_expression = 98,           /* cast_expression  */
+  YYSYMBOL_multiplicative_expression = 99, /* multiplicative_expression  */
+  YYSYMBOL_additive_expression = 100,      /* additive_expression  */
+  YYSYMBOL_shift_expression = 101,         /* shift_expression  */
+  YYSYMBOL_relational_expression = 102,    /* relational_expression  */
+  YYSYMBOL_equality_expression = 103,      /* equality_expression  */
+  YYSYMBOL_and_expression = 104,           /* and_expression  */
+  YYSYMBOL_exclusive_or_expression = 105,  /* exclusive_or_expression  */
+  YYSYMBOL_inclusive_or_expression = 106,  /* inclusive_or_expression  */
+  YYSYMBOL_logical_and_expression = 107,   /* logical_and_expression  */
+  YYSYMBOL_logical_or_expression = 108,    /* logical_or_expression  */
+  YYSYMBOL_conditional_expression = 109,   /* conditional_expression  */
+  YYSYMBOL_assignment_expression = 110,    /* assignment_expression  */
+  YYSYMBOL_expression = 111,               /* expression  */
+  YYSYMBOL_constant_expression = 112,      /* constant_expression  */
+  YYSYMBOL_declaration = 113,              /* declaration  */
+  YYSYMBOL_declaration_specifiers = 114,   /* declaration_specifiers  */
+  YYSYMBOL_init_declarator_list = 115,     /* init_declarator_list  */
+  YYSYMBOL_init_declarator = 116,          /* init_declarator  */
+  YYSYMBOL_storage_class_specifier = 117,  /* storage_class_specifier  */
+  YYSYMBOL_type_specifier = 118,           /* type_specifier  */
+  YYSYMBOL_struct_specifier = 119,         /* struct_specifier  */
+  YYSYMBOL_struct_declaration_list = 120,  /* struct_declaration_list  */
+  YYSYMBOL_struct_declaration = 121,       /* struct_declaration  */
+  YYSYMBOL_specifier_qualifier_list = 122, /* specifier_qualifier_list  */
+  YYSYMBOL_struct_declarator_list = 123,   /* struct_declarator_list  */
+  YYSYMBOL_struct_declarator = 124,        /* struct_declarator  */
+  YYSYMBOL_enum_specifier = 125,           /* enum_specifier  */
+  YYSYMBOL_enumerator_list = 126,          /* enumerator_list  */
+  YYSYMBOL_enumerator = 127,               /* enumerator  */
+  YYSYMBOL_declarator = 128,               /* declarator  */
+  YYSYMBOL_direct_declarator = 129,        /* direct_declarator  */
+  YYSYMBOL_pointer = 130,                  /* pointer  */
+  YYSYMBOL_parameter_list = 131,           /* parameter_list  */
+  YYSYMBOL_parameter_declaration = 132,    /* parameter_declaration  */
+  YYSYMBOL_identifier_list = 133,          /* identifier_list  */
+  YYSYMBOL_type_name = 134,                /* type_name  */
+  YYSYMBOL_abstract_declarator = 135,      /* abstract_declarator  */
+  YYSYMBOL_direct_abstract_declarator = 136, /* direct_abstract_declarator  */
+  YYSYMBOL_initializer = 137,              /* initializer  */
+  YYSYMBOL_initializer_list = 138,         /* initializer_list  */
+  YYSYMBOL_statement = 139,                /* statement  */
+  YYSYMBOL_labeled_statement = 140,        /* labeled_statement  */
+  YYSYMBOL_compound_statement = 141,       /* compound_statement  */
+  YYSYMBOL_declaration_list = 142,         /* declaration_list  */
+  YYSYMBOL_statement_list = 143,           /* statement_list  */
+  YYSYMBOL_expression_statement = 144,     /* expression_statement  */
+  YYSYMBOL_selection_statement = 145,      /* selection_statement  */
+  YYSYMBOL_iteration_statement = 146,      /* iteration_statement  */
+  YYSYMBOL_jump_statement = 147            /* jump_statement  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 16 "src/parser.y"
+
+    #include "statistics.h"
+
+    int yylex_init_extra(ParserState *extra, yyscan_t *scanner);
+    ParserState *yyget_extra(yyscan_t scanner);
+    void yyset_in(FILE *file, yyscan_t scanner);
+    int yylex_destroy(yyscan_t scanner);
+
+    // Lexing happens as the parser asks for each token, so its cost is
+    // measured around every call, for -ftime-report
+    static int TimedLex(YYSTYPE *value, yyscan_t scanner)
+    {
+        PhaseTiming *lexing = yyget_extra(scanner)->lexing;
+        if (lexing == nullptr)
+        {
+            return yylex(value, scanner);
+        }
+        ResourceSnapshot start = TakeSnapshot();
+        int token = yylex(value, scanner);
+        lexing->add(start, TakeSnapshot());
+        return token;
+    }
+    #define yylex TimedLex
+
+    // Returns the declaration to add to the translation unit, or nullptr if
+    // it went straight to the backend
+    static Node *TakeDeclaration(ParserState *state, Node *declaration)
+    {
+        if (!state->declaration)
+        {
+            return declaration;
+        }
+        state->declaration(declaration);
+        return nullptr;
+    }
+
+#line 288 "build/parser.tab.cpp"
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  43
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   1196
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  87
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  61
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  205
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  366
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   317
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    75,     2,     2,     2,    77,    70,     2,
+      64,    65,    71,    72,    69,    73,    68,    76,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    83,    63,
+      78,    84,    79,    82,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    66,     2,    67,    80,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    85,    81,    86,    74,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   102,   102,   105,   106,   110,   111,   118,   122,   123,
+     126,   127,   128,   129,   133,   140,   141,   146,   150,   153,
+     156,   159,   163,   164,   165,   166,   167,   168,   169,   170,
+     174,   175,   179,   180,   181,   182,   183,   184,   188,   189,
+     190,   191,   192,   193,   197,   198,   202,   203,   204,   205,
+     209,   210,   211,   215,   216,   217,   221,   222,   223,   224,
+     225,   229,   230,   231,   235,   236,   240,   241,   245,   246,
+     250,   251,   255,   256,   261,   262,   266,   267,   268,   269,
+     270,   271,   272,   273,   274,   275,   276,   277,   295,   296,
+     300,   304,   305,   309,   313,   317,   318,   322,   323,   327,
+     328,   334,   335,   336,   337,   338,   342,   345,   348,   351,
+     354,   357,   360,   363,   366,   369,   370,   371,   375,   376,
+     377,   381,   382,   386,   390,   391,   395,   396,   400,   401,
+     402,   406,   407,   408,   412,   413,   417,   418,   422,   423,
+     427,   431,   432,   433,   434,   435,   436,   442,   443,   447,
+     448,   452,   453,   454,   458,   459,   463,   464,   468,   469,
+     470,   474,   475,   476,   477,   478,   479,   480,   481,   482,
+     486,   487,   488,   492,   493,   497,   498,   499,   500,   501,
+     502,   506,   507,   508,   512,   515,   518,   521,   528,   529,
+     533,   534,   540,   541,   545,   546,   547,   551,   552,   553,
+     554,   558,   559,   560,   561,   564
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "IDENTIFIER",
+  "INT_CONSTANT", "FLOAT_CONSTANT", "STRING_LITERAL", "PTR_OP", "INC_OP",
+  "DEC_OP", "LEFT_OP", "RIGHT_OP", "LE_OP", "GE_OP", "EQ_OP", "NE_OP",
+  "AND_OP", "OR_OP", "MUL_ASSIGN", "DIV_ASSIGN", "MOD_ASSIGN",
+  "ADD_ASSIGN", "SUB_ASSIGN", "LEFT_ASSIGN", "RIGHT_ASSIGN", "AND_ASSIGN",
+  "XOR_ASSIGN", "OR_ASSIGN", "TYPE_NAME", "TYPEDEF", "EXTERN", "STATIC",
+  "AUTO", "REGISTER", "SIZEOF", "CHAR", "SHORT", "INT", "LONG", "SIGNED",
+  "UNSIGNED", "FLOAT", "DOUBLE", "CONST", "VOLATILE", "VOID", "STRUCT",
+  "UNION", "ENUM", "ELLIPSIS", "ATTRIBUTE", "CASE", "DEFAULT", "IF",
+  "ELSE", "SWITCH", "WHILE", "DO", "FOR", "GOTO", "CONTINUE", "BREAK",
+  "RETURN", "';'", "'('", "')'", "'['", "']'", "'.'", "','", "'&'", "'*'",
+  "'+'", "'-'", "'~'", "'!'", "'/'", "'%'", "'<'", "'>'", "'^'", "'|'",
+  "'?'", "':'", "'='", "'{'", "'}'", "$accept", "ROOT", "translation_unit",
+  "external_declaration", "function_definition", "attribute_specifier",
+  "primary_expression", "postfix_expression", "argument_expression_list",
+  "unary_expression", "unary_operator", "cast_expression",
+  "multiplicative_expression", "additive_expression", "shift_expression",
+  "relational_expression", "equality_expression", "and_expression",
+  "exclusive_or_expression", "inclusive_or_expression",
+  "logical_and_expression", "logical_or_expression",
+  "conditional_expression", "assignment_expression", "expression",
+  "constant_expression", "declaration", "declaration_specifiers",
+  "init_declarator_list", "init_declarator", "storage_class_specifier",
+  "type_specifier", "struct_specifier", "struct_declaration_list",
+  "struct_declaration", "specifier_qualifier_list",
+  "struct_declarator_list", "struct_declarator", "enum_specifier",
+  "enumerator_list", "enumerator", "declarator", "direct_declarator",
+  "pointer", "parameter_list", "parameter_declaration", "identifier_list",
+  "type_name", "abstract_declarator", "direct_abstract_declarator",
+  "initializer", "initializer_list", "statement", "labeled_statement",
+  "compound_statement", "declaration_list", "statement_list",
+  "expression_statement", "selection_statement", "iteration_statement",
+  "jump_statement", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-199)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     938,  -199,  -199,  -199,  -199,  -199,  -199,  -199,  -199,  -199,
+    -199,  -199,  -199,  -199,  -199,  -199,  -199,     6,    16,   -47,
+      24,   -34,    65,   938,   938,  -199,  1148,  -199,    15,  1148,
+    1148,  -199,  -199,  1061,    88,    19,     2,   517,    34,    74,
+     112,   114,  -199,  -199,   938,  -199,    24,    24,  -199,    -2,
+    -199,  1003,  -199,  -199,   296,  -199,    15,  -199,  1061,   982,
+     608,    88,   517,   517,   275,  -199,    68,    74,   113,   -33,
+    -199,     7,  -199,  1032,    78,  -199,    24,  -199,   535,   140,
+    -199,  1061,   130,  -199,  -199,  -199,   809,   809,   829,   882,
+     148,   179,   191,   195,   588,   198,   266,   216,   219,   217,
+    -199,   661,  -199,  -199,  -199,  -199,  -199,  -199,  -199,  -199,
+     141,   365,   882,  -199,   109,     3,   227,    57,   257,   213,
+     206,   212,   282,   -10,  -199,  -199,    33,  -199,  -199,  -199,
+     369,   442,  -199,  -199,  -199,  -199,   222,  -199,  -199,  -199,
+    -199,    46,   -18,  -199,   133,  -199,  -199,  -199,  -199,   240,
+     444,  -199,  -199,  -199,   882,    40,  -199,   225,   -26,   882,
+      74,  -199,   244,   254,  -199,  -199,   535,  -199,  -199,  -199,
+    -199,   588,   882,  -199,  -199,   661,  -199,   239,   588,   882,
+     882,   882,   283,   682,   277,  -199,  -199,  -199,    75,   135,
+      76,   278,   347,  -199,  -199,   709,   882,   359,   882,   882,
+     882,   882,   882,   882,   882,   882,   882,   882,   882,  -199,
+     882,   882,   882,   882,   882,   882,   882,   882,   882,   882,
+     882,   882,   882,   882,   882,   882,   882,   882,   882,  -199,
+     882,  -199,   515,  -199,  -199,   894,   755,  -199,    18,  -199,
+     124,  -199,  1148,  -199,   360,  -199,  -199,  -199,  -199,    68,
+     882,  -199,  -199,  -199,   299,   300,  -199,    11,  -199,   311,
+     588,  -199,   145,   146,   147,   315,   682,  -199,  -199,  -199,
+    1083,   190,  -199,   882,  -199,  -199,   164,  -199,   199,  -199,
+    -199,  -199,  -199,  -199,  -199,  -199,  -199,  -199,  -199,  -199,
+    -199,  -199,  -199,  -199,   109,   109,     3,     3,   227,   227,
+     227,   227,    57,    57,   257,   213,   206,   212,   282,   -27,
+    -199,  -199,  -199,   165,   328,  -199,   313,   124,  1127,   782,
+    -199,  -199,  -199,  -199,  -199,  -199,   462,  -199,  -199,  -199,
+     588,   588,   588,   882,   797,  -199,  -199,   882,  -199,   882,
+    -199,  -199,  -199,  -199,   167,  -199,   327,  -199,  -199,   341,
+    -199,  -199,   183,   588,   188,  -199,  -199,  -199,  -199,   588,
+     333,  -199,   588,  -199,  -199,  -199
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,   140,   117,   101,   102,   103,   104,   105,   107,   108,
+     109,   110,   113,   114,   111,   112,   106,     0,     0,     0,
+       0,   147,     0,     2,     3,     5,     0,     7,     0,    93,
+      95,   115,   116,     0,   139,     0,   120,     0,   133,     0,
+       0,     0,   148,     1,     4,     6,     0,     0,    91,     0,
+      97,    99,    94,    96,     0,   188,     0,    11,     0,     0,
+       0,   138,     0,   125,     0,   121,     0,     0,   136,     0,
+     134,     0,   141,     0,     0,    92,     0,    12,     0,     0,
+       9,     0,    17,    18,    19,    20,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+     192,     0,    38,    39,    40,    41,    42,    43,   184,    22,
+      32,    44,     0,    46,    50,    53,    56,    61,    64,    66,
+      68,    70,    72,    74,    76,    88,     0,   190,   175,   176,
+       0,     0,   177,   178,   179,   180,    99,   189,    10,   154,
+     146,   153,     0,   149,     0,    17,   143,    44,    90,     0,
+       0,   124,   119,   122,     0,     0,   126,   128,     0,     0,
+       0,   131,     0,     0,    14,    98,     0,   170,   100,    13,
+       8,     0,     0,    33,    34,     0,    36,     0,     0,     0,
+       0,     0,     0,     0,     0,   202,   203,   204,     0,     0,
+     156,     0,     0,    28,    29,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    35,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   193,
+       0,   186,     0,   185,   191,     0,     0,   151,   158,   152,
+     159,   144,     0,   145,     0,   142,   118,   129,   123,     0,
+       0,   132,   137,   135,     0,     0,   173,     0,   181,     0,
+       0,   183,     0,     0,     0,     0,     0,   201,   205,    21,
+       0,   158,   157,     0,    27,    24,     0,    30,     0,    26,
+      80,    81,    82,    78,    79,    83,    84,    85,    87,    86,
+      77,    47,    48,    49,    51,    52,    54,    55,    59,    60,
+      57,    58,    62,    63,    65,    67,    69,    71,    73,     0,
+      89,   187,   166,     0,     0,   162,     0,   160,     0,     0,
+     150,   155,   127,   130,    15,    16,     0,   171,    37,   182,
+       0,     0,     0,     0,     0,    45,    25,     0,    23,     0,
+     167,   161,   163,   168,     0,   164,     0,   172,   174,   194,
+     196,   197,     0,     0,     0,    31,    75,   169,   165,     0,
+       0,   199,     0,   195,   198,   200
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -199,  -199,  -199,   389,    22,     1,  -199,  -199,  -199,   -55,
+    -199,   -96,  -159,    59,    77,    56,   193,   189,   194,   192,
+     196,  -199,   -54,   -77,    12,   -61,   120,     0,  -199,   358,
+    -199,    44,  -199,   373,   -60,   -38,  -199,   187,  -199,   370,
+     292,    -8,   -32,    -7,   -57,   211,  -199,   263,  -126,  -198,
+    -153,  -199,   -86,  -199,   166,     8,   326,  -172,  -199,  -199,
+    -199
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    22,    23,    24,    25,    26,   109,   110,   276,   111,
+     112,   113,   114,   115,   116,   117,   118,   119,   120,   121,
+     122,   123,   124,   125,   126,   149,    55,    56,    49,    50,
+      29,    30,    31,    64,    65,    66,   155,   156,    32,    69,
+      70,    33,    34,    35,   313,   143,   144,   191,   314,   240,
+     168,   257,   127,   128,   129,    81,   131,   132,   133,   134,
+     135
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      28,   167,   142,    61,   153,   147,   148,   227,   182,    36,
+     162,   266,    41,   256,    42,   239,   209,    40,     1,    38,
+      51,     1,     1,    28,    46,   151,    47,     1,   177,    52,
+      53,   173,   174,   176,   147,   148,   160,    21,    73,    74,
+     317,    58,   230,   160,    46,   234,    45,   241,   136,     1,
+     163,   242,    79,   161,   294,   295,   339,   147,   157,   141,
+     251,    75,   130,   190,   272,    43,    45,    76,   136,   217,
+     218,     1,   228,   317,    79,   213,   214,    68,    48,    20,
+     326,    63,   235,    20,   236,   258,    21,    62,    20,   167,
+     153,    37,   261,   247,   334,    21,   229,   327,   252,   147,
+     148,    39,   230,   248,   147,   148,    63,    63,    63,   249,
+     235,   188,   236,   189,   291,   292,   293,    21,   277,    67,
+      27,   280,   281,   282,   283,   284,   285,   286,   287,   288,
+     289,   290,    20,   237,   238,   219,   220,   190,   268,    21,
+     270,   164,   236,    27,   230,    63,   234,    21,   192,   193,
+     194,   154,    59,   310,    60,   147,   147,   147,   147,   147,
+     147,   147,   147,   147,   147,   147,   147,   147,   147,   147,
+     147,   147,   147,   348,   329,   316,    71,   335,   137,    72,
+     210,   147,   148,   271,   189,   211,   212,   189,   318,   323,
+     319,   262,   263,   264,    63,   147,   148,   159,   243,    57,
+     269,   137,   244,   169,   230,   195,    61,   196,   278,   197,
+     330,   331,   332,   171,   230,   230,   230,    80,   147,    63,
+     145,    83,    84,    85,   138,    86,    87,    41,   238,   336,
+     340,   178,   357,   337,   242,   141,   242,   215,   216,    80,
+     309,   157,   141,   179,   349,   350,   351,   170,   360,   167,
+     137,    88,   230,   362,   270,   180,   236,   230,   346,   181,
+     355,   344,   183,   271,   147,   148,   338,   361,   230,   184,
+     141,   221,   222,   363,   296,   297,   365,   302,   303,   185,
+     187,   101,   186,   223,   147,   356,   224,   102,   103,   104,
+     105,   106,   107,   225,   298,   299,   300,   301,   226,    82,
+      83,    84,    85,     2,    86,    87,    78,   245,   250,   254,
+       8,     9,    10,    11,    12,    13,    14,    15,   141,   255,
+      16,    17,   260,    18,     2,     3,     4,     5,     6,     7,
+      88,     8,     9,    10,    11,    12,    13,    14,    15,   265,
+     267,    16,    17,   273,    18,   352,   354,    89,    90,    91,
+     274,    92,    93,    94,    95,    96,    97,    98,    99,   100,
+     101,   152,   279,   321,   324,   325,   102,   103,   104,   105,
+     106,   107,    82,    83,    84,    85,   328,    86,    87,   333,
+     342,    54,   108,   198,   199,   200,   201,   202,   203,   204,
+     205,   206,   207,   341,   358,   359,   364,     2,     3,     4,
+       5,     6,     7,    88,     8,     9,    10,    11,    12,    13,
+      14,    15,    44,   305,    16,    17,   304,    18,   307,   306,
+      89,    90,    91,   308,    92,    93,    94,    95,    96,    97,
+      98,    99,   100,   101,   165,   150,   322,   158,   259,   102,
+     103,   104,   105,   106,   107,    82,    83,    84,    85,   208,
+      86,    87,   253,   320,    54,   231,   232,     0,     0,     0,
+       0,     0,     0,     0,     0,   145,    83,    84,    85,     0,
+      86,    87,     2,     0,     0,     0,    88,     0,     0,     8,
+       9,    10,    11,    12,    13,    14,    15,     0,     0,    16,
+      17,     0,    18,    89,    90,    91,    88,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,     0,     0,     0,
+       0,     0,   102,   103,   104,   105,   106,   107,    82,    83,
+      84,    85,     0,    86,    87,     0,   101,    54,   233,     0,
+     246,     0,   102,   103,   104,   105,   106,   107,   145,    83,
+      84,    85,     0,    86,    87,     2,     0,   166,   347,    88,
+       0,     0,     8,     9,    10,    11,    12,    13,    14,    15,
+       0,     0,    16,    17,     0,    18,    89,    90,    91,    88,
+      92,    93,    94,    95,    96,    97,    98,    99,   100,   101,
+       0,     0,     0,     0,     0,   102,   103,   104,   105,   106,
+     107,    82,    83,    84,    85,     0,    86,    87,     0,   101,
+      54,   311,     0,     0,     0,   102,   103,   104,   105,   106,
+     107,   145,    83,    84,    85,     0,    86,    87,     0,     0,
+     166,     0,    88,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    89,
+      90,    91,    88,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,     0,     0,     0,     0,     0,   102,   103,
+     104,   105,   106,   107,   145,    83,    84,    85,     0,    86,
+      87,     0,   101,    54,     0,   146,     0,     0,   102,   103,
+     104,   105,   106,   107,     0,   145,    83,    84,    85,     2,
+      86,    87,     0,     0,     0,    88,     8,     9,    10,    11,
+      12,    13,    14,    15,     0,     0,    16,    17,     0,    18,
+       0,     0,   145,    83,    84,    85,    88,    86,    87,     0,
+       0,     0,     0,     0,     0,   101,     0,     0,     0,     0,
+       0,   102,   103,   104,   105,   106,   107,     0,     0,     0,
+       0,     0,     0,    88,     0,   100,   101,     0,     0,     0,
+       0,     0,   102,   103,   104,   105,   106,   107,   145,    83,
+      84,    85,     0,    86,    87,     0,     0,     0,     0,     0,
+       0,     0,     0,   101,   275,     0,     0,     0,     0,   102,
+     103,   104,   105,   106,   107,   145,    83,    84,    85,    88,
+      86,    87,     0,     0,     0,     0,     0,     0,     0,     0,
+     145,    83,    84,    85,     0,    86,    87,     0,     0,     0,
+       0,     0,   145,    83,    84,    85,    88,    86,    87,   101,
+       0,     0,   315,     0,     0,   102,   103,   104,   105,   106,
+     107,    88,   145,    83,    84,    85,     0,    86,    87,     0,
+       0,     0,     0,    88,     0,     0,   101,     0,     0,   345,
+       0,     0,   102,   103,   104,   105,   106,   107,     0,     0,
+       0,   101,   353,    88,     0,     0,     0,   102,   103,   104,
+     105,   106,   107,   172,     0,     0,     0,     0,     0,   102,
+     103,   104,   105,   106,   107,   145,    83,    84,    85,     0,
+      86,    87,     0,   175,     0,     0,     0,     1,     0,   102,
+     103,   104,   105,   106,   107,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    88,     0,     0,     0,
+       0,     0,     2,     3,     4,     5,     6,     7,     0,     8,
+       9,    10,    11,    12,    13,    14,    15,     0,     0,    16,
+      17,     1,    18,     0,     0,     0,   101,     0,     0,     0,
+       0,     0,   102,   103,   104,   105,   106,   107,   235,   312,
+     236,     0,     0,     0,     0,    21,     2,     3,     4,     5,
+       6,     7,     0,     8,     9,    10,    11,    12,    13,    14,
+      15,     0,     0,    16,    17,   139,    18,     0,    19,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    20,     0,     0,     0,     0,     0,     0,    21,
+       2,     3,     4,     5,     6,     7,     0,     8,     9,    10,
+      11,    12,    13,    14,    15,     0,     0,    16,    17,     0,
+      18,     2,     3,     4,     5,     6,     7,     0,     8,     9,
+      10,    11,    12,    13,    14,    15,     0,   140,    16,    17,
+       0,    18,     0,    19,     0,     0,     0,     0,     0,     0,
+       2,     3,     4,     5,     6,     7,    77,     8,     9,    10,
+      11,    12,    13,    14,    15,     0,     0,    16,    17,     0,
+      18,     0,    19,     0,     0,     0,     0,    78,    54,     2,
+       3,     4,     5,     6,     7,    77,     8,     9,    10,    11,
+      12,    13,    14,    15,     0,     0,    16,    17,     0,    18,
+       0,     2,     3,     4,     5,     6,     7,    54,     8,     9,
+      10,    11,    12,    13,    14,    15,     0,     0,    16,    17,
+       0,    18,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    54,   270,   312,   236,
+       0,     0,     0,     0,    21,     2,     3,     4,     5,     6,
+       7,     0,     8,     9,    10,    11,    12,    13,    14,    15,
+       0,     0,    16,    17,     0,    18,     2,     3,     4,     5,
+       6,     7,     0,     8,     9,    10,    11,    12,    13,    14,
+      15,     0,   343,    16,    17,     0,    18
+};
+
+static const yytype_int16 yycheck[] =
+{
+       0,    78,    59,    35,    64,    60,    60,    17,    94,     3,
+       3,   183,    20,   166,    21,   141,   112,    64,     3,     3,
+      28,     3,     3,    23,    24,    63,    26,     3,    89,    29,
+      30,    86,    87,    88,    89,    89,    69,    71,    46,    47,
+     238,    33,    69,    69,    44,   131,    24,    65,    56,     3,
+      43,    69,    51,    86,   213,   214,    83,   112,    66,    59,
+      86,    63,    54,   101,   190,     0,    44,    69,    76,    12,
+      13,     3,    82,   271,    73,    72,    73,     3,    63,    64,
+      69,    37,    64,    64,    66,   171,    71,    85,    64,   166,
+     150,    85,   178,   154,   266,    71,    63,    86,   159,   154,
+     154,    85,    69,    63,   159,   159,    62,    63,    64,    69,
+      64,    99,    66,   101,   210,   211,   212,    71,   195,    85,
+       0,   198,   199,   200,   201,   202,   203,   204,   205,   206,
+     207,   208,    64,   141,   141,    78,    79,   175,    63,    71,
+      64,    63,    66,    23,    69,   101,   232,    71,     7,     8,
+       9,    83,    64,   230,    66,   210,   211,   212,   213,   214,
+     215,   216,   217,   218,   219,   220,   221,   222,   223,   224,
+     225,   226,   227,   326,   260,   236,    64,   273,    58,    65,
+      71,   236,   236,   190,   172,    76,    77,   175,    64,   250,
+      66,   179,   180,   181,   150,   250,   250,    84,    65,    33,
+      65,    81,    69,    63,    69,    64,   238,    66,   196,    68,
+      65,    65,    65,    83,    69,    69,    69,    51,   273,   175,
+       3,     4,     5,     6,    58,     8,     9,   235,   235,    65,
+      65,    83,    65,    69,    69,   235,    69,    10,    11,    73,
+     228,   249,   242,    64,   330,   331,   332,    81,    65,   326,
+     130,    34,    69,    65,    64,    64,    66,    69,   319,    64,
+     337,   318,    64,   270,   319,   319,    67,   353,    69,     3,
+     270,    14,    15,   359,   215,   216,   362,   221,   222,    63,
+      63,    64,    63,    70,   339,   339,    80,    70,    71,    72,
+      73,    74,    75,    81,   217,   218,   219,   220,    16,     3,
+       4,     5,     6,    28,     8,     9,    84,    67,    83,    65,
+      35,    36,    37,    38,    39,    40,    41,    42,   318,    65,
+      45,    46,    83,    48,    28,    29,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    56,
+      63,    45,    46,    65,    48,   333,   334,    51,    52,    53,
+       3,    55,    56,    57,    58,    59,    60,    61,    62,    63,
+      64,    86,     3,     3,    65,    65,    70,    71,    72,    73,
+      74,    75,     3,     4,     5,     6,    65,     8,     9,    64,
+      67,    85,    86,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    65,    67,    54,    63,    28,    29,    30,
+      31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
+      41,    42,    23,   224,    45,    46,   223,    48,   226,   225,
+      51,    52,    53,   227,    55,    56,    57,    58,    59,    60,
+      61,    62,    63,    64,    76,    62,   249,    67,   175,    70,
+      71,    72,    73,    74,    75,     3,     4,     5,     6,    84,
+       8,     9,   160,   242,    85,    86,   130,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,     3,     4,     5,     6,    -1,
+       8,     9,    28,    -1,    -1,    -1,    34,    -1,    -1,    35,
+      36,    37,    38,    39,    40,    41,    42,    -1,    -1,    45,
+      46,    -1,    48,    51,    52,    53,    34,    55,    56,    57,
+      58,    59,    60,    61,    62,    63,    64,    -1,    -1,    -1,
+      -1,    -1,    70,    71,    72,    73,    74,    75,     3,     4,
+       5,     6,    -1,     8,     9,    -1,    64,    85,    86,    -1,
+      86,    -1,    70,    71,    72,    73,    74,    75,     3,     4,
+       5,     6,    -1,     8,     9,    28,    -1,    85,    86,    34,
+      -1,    -1,    35,    36,    37,    38,    39,    40,    41,    42,
+      -1,    -1,    45,    46,    -1,    48,    51,    52,    53,    34,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      -1,    -1,    -1,    -1,    -1,    70,    71,    72,    73,    74,
+      75,     3,     4,     5,     6,    -1,     8,     9,    -1,    64,
+      85,    86,    -1,    -1,    -1,    70,    71,    72,    73,    74,
+      75,     3,     4,     5,     6,    -1,     8,     9,    -1,    -1,
+      85,    -1,    34,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    51,
+      52,    53,    34,    55,    56,    57,    58,    59,    60,    61,
+      62,    63,    64,    -1,    -1,    -1,    -1,    -1,    70,    71,
+      72,    73,    74,    75,     3,     4,     5,     6,    -1,     8,
+       9,    -1,    64,    85,    -1,    67,    -1,    -1,    70,    71,
+      72,    73,    74,    75,    -1,     3,     4,     5,     6,    28,
+       8,     9,    -1,    -1,    -1,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    -1,    -1,    45,    46,    -1,    48,
+      -1,    -1,     3,     4,     5,     6,    34,     8,     9,    -1,
+      -1,    -1,    -1,    -1,    -1,    64,    -1,    -1,    -1,    -1,
+      -1,    70,    71,    72,    73,    74,    75,    -1,    -1,    -1,
+      -1,    -1,    -1,    34,    -1,    63,    64,    -1,    -1,    -1,
+      -1,    -1,    70,    71,    72,    73,    74,    75,     3,     4,
+       5,     6,    -1,     8,     9,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    64,    65,    -1,    -1,    -1,    -1,    70,
+      71,    72,    73,    74,    75,     3,     4,     5,     6,    34,
+       8,     9,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+       3,     4,     5,     6,    -1,     8,     9,    -1,    -1,    -1,
+      -1,    -1,     3,     4,     5,     6,    34,     8,     9,    64,
+      -1,    -1,    67,    -1,    -1,    70,    71,    72,    73,    74,
+      75,    34,     3,     4,     5,     6,    -1,     8,     9,    -1,
+      -1,    -1,    -1,    34,    -1,    -1,    64,    -1,    -1,    67,
+      -1,    -1,    70,    71,    72,    73,    74,    75,    -1,    -1,
+      -1,    64,    65,    34,    -1,    -1,    -1,    70,    71,    72,
+      73,    74,    75,    64,    -1,    -1,    -1,    -1,    -1,    70,
+      71,    72,    73,    74,    75,     3,     4,     5,     6,    -1,
+       8,     9,    -1,    64,    -1,    -1,    -1,     3,    -1,    70,
+      71,    72,    73,    74,    75,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    34,    -1,    -1,    -1,
+      -1,    -1,    28,    29,    30,    31,    32,    33,    -1,    35,
+      36,    37,    38,    39,    40,    41,    42,    -1,    -1,    45,
+      46,     3,    48,    -1,    -1,    -1,    64,    -1,    -1,    -1,
+      -1,    -1,    70,    71,    72,    73,    74,    75,    64,    65,
+      66,    -1,    -1,    -1,    -1,    71,    28,    29,    30,    31,
+      32,    33,    -1,    35,    36,    37,    38,    39,    40,    41,
+      42,    -1,    -1,    45,    46,     3,    48,    -1,    50,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    64,    -1,    -1,    -1,    -1,    -1,    -1,    71,
+      28,    29,    30,    31,    32,    33,    -1,    35,    36,    37,
+      38,    39,    40,    41,    42,    -1,    -1,    45,    46,    -1,
+      48,    28,    29,    30,    31,    32,    33,    -1,    35,    36,
+      37,    38,    39,    40,    41,    42,    -1,    65,    45,    46,
+      -1,    48,    -1,    50,    -1,    -1,    -1,    -1,    -1,    -1,
+      28,    29,    30,    31,    32,    33,    63,    35,    36,    37,
+      38,    39,    40,    41,    42,    -1,    -1,    45,    46,    -1,
+      48,    -1,    50,    -1,    -1,    -1,    -1,    84,    85,    28,
+      29,    30,    31,    32,    33,    63,    35,    36,    37,    38,
+      39,    40,    41,    42,    -1,    -1,    45,    46,    -1,    48,
+      -1,    28,    29,    30,    31,    32,    33,    85,    35,    36,
+      37,    38,    39,    40,    41,    42,    -1,    -1,    45,    46,
+      -1,    48,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    85,    64,    65,    66,
+      -1,    -1,    -1,    -1,    71,    28,    29,    30,    31,    32,
+      33,    -1,    35,    36,    37,    38,    39,    40,    41,    42,
+      -1,    -1,    45,    46,    -1,    48,    28,    29,    30,    31,
+      32,    33,    -1,    35,    36,    37,    38,    39,    40,    41,
+      42,    -1,    65,    45,    46,    -1,    48
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,     3,    28,    29,    30,    31,    32,    33,    35,    36,
+      37,    38,    39,    40,    41,    42,    45,    46,    48,    50,
+      64,    71,    88,    89,    90,    91,    92,   113,   114,   117,
+     118,   119,   125,   128,   129,   130,     3,    85,     3,    85,
+      64,   128,   130,     0,    90,    91,   114,   114,    63,   115,
+     116,   128,   114,   114,    85,   113,   114,   141,   142,    64,
+      66,   129,    85,   118,   120,   121,   122,    85,     3,   126,
+     127,    64,    65,   128,   128,    63,    69,    63,    84,    92,
+     141,   142,     3,     4,     5,     6,     8,     9,    34,    51,
+      52,    53,    55,    56,    57,    58,    59,    60,    61,    62,
+      63,    64,    70,    71,    72,    73,    74,    75,    86,    93,
+      94,    96,    97,    98,    99,   100,   101,   102,   103,   104,
+     105,   106,   107,   108,   109,   110,   111,   139,   140,   141,
+     142,   143,   144,   145,   146,   147,   128,   113,   141,     3,
+      65,   114,   131,   132,   133,     3,    67,    96,   109,   112,
+     120,   122,    86,   121,    83,   123,   124,   128,   126,    84,
+      69,    86,     3,    43,    63,   116,    85,   110,   137,    63,
+     141,    83,    64,    96,    96,    64,    96,   112,    83,    64,
+      64,    64,   139,    64,     3,    63,    63,    63,   111,   111,
+     122,   134,     7,     8,     9,    64,    66,    68,    18,    19,
+      20,    21,    22,    23,    24,    25,    26,    27,    84,    98,
+      71,    76,    77,    72,    73,    10,    11,    12,    13,    78,
+      79,    14,    15,    70,    80,    81,    16,    17,    82,    63,
+      69,    86,   143,    86,   139,    64,    66,   128,   130,   135,
+     136,    65,    69,    65,    69,    67,    86,   112,    63,    69,
+      83,    86,   112,   127,    65,    65,   137,   138,   139,   134,
+      83,   139,   111,   111,   111,    56,   144,    63,    63,    65,
+      64,   130,   135,    65,     3,    65,    95,   110,   111,     3,
+     110,   110,   110,   110,   110,   110,   110,   110,   110,   110,
+     110,    98,    98,    98,    99,    99,   100,   100,   101,   101,
+     101,   101,   102,   102,   103,   104,   105,   106,   107,   111,
+     110,    86,    65,   131,   135,    67,   112,   136,    64,    66,
+     132,     3,   124,   112,    65,    65,    69,    86,    65,   139,
+      65,    65,    65,    64,   144,    98,    65,    69,    67,    83,
+      65,    65,    67,    65,   131,    67,   112,    86,   137,   139,
+     139,   139,   111,    65,   111,   110,   109,    65,    67,    54,
+      65,   139,    65,   139,    63,   139
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    87,    88,    89,    89,    90,    90,    90,    91,    91,
+      91,    91,    91,    91,    91,    92,    92,    93,    93,    93,
+      93,    93,    94,    94,    94,    94,    94,    94,    94,    94,
+      95,    95,    96,    96,    96,    96,    96,    96,    97,    97,
+      97,    97,    97,    97,    98,    98,    99,    99,    99,    99,
+     100,   100,   100,   101,   101,   101,   102,   102,   102,   102,
+     102,   103,   103,   103,   104,   104,   105,   105,   106,   106,
+     107,   107,   108,   108,   109,   109,   110,   110,   110,   110,
+     110,   110,   110,   110,   110,   110,   110,   110,   111,   111,
+     112,   113,   113,   114,   114,   114,   114,   115,   115,   116,
+     116,   117,   117,   117,   117,   117,   118,   118,   118,   118,
+     118,   118,   118,   118,   118,   118,   118,   118,   119,   119,
+     119,   120,   120,   121,   122,   122,   123,   123,   124,   124,
+     124,   125,   125,   125,   126,   126,   127,   127,   128,   128,
+     129,   129,   129,   129,   129,   129,   129,   130,   130,   131,
+     131,   132,   132,   132,   133,   133,   134,   134,   135,   135,
+     135,   136,   136,   136,   136,   136,   136,   136,   136,   136,
+     137,   137,   137,   138,   138,   139,   139,   139,   139,   139,
+     139,   140,   140,   140,   141,   141,   141,   141,   142,   142,
+     143,   143,   144,   144,   145,   145,   145,   146,   146,   146,
+     146,   147,   147,   147,   147,   147
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     2,     1,     2,     1,     4,     3,
+       3,     2,     3,     4,     4,     6,     6,     1,     1,     1,
+       1,     3,     1,     4,     3,     4,     3,     3,     2,     2,
+       1,     3,     1,     2,     2,     2,     2,     4,     1,     1,
+       1,     1,     1,     1,     1,     4,     1,     3,     3,     3,
+       1,     3,     3,     1,     3,     3,     1,     3,     3,     3,
+       3,     1,     3,     3,     1,     3,     1,     3,     1,     3,
+       1,     3,     1,     3,     1,     5,     1,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     1,     3,
+       1,     2,     3,     1,     2,     1,     2,     1,     3,     1,
+       3,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     5,     4,
+       2,     1,     2,     3,     2,     1,     1,     3,     1,     2,
+       3,     4,     5,     2,     1,     3,     1,     3,     2,     1,
+       1,     3,     4,     3,     4,     4,     3,     1,     2,     1,
+       3,     2,     2,     1,     1,     3,     1,     2,     1,     1,
+       2,     3,     2,     3,     3,     4,     2,     3,     3,     4,
+       1,     3,     4,     1,     3,     1,     1,     1,     1,     1,
+       1,     3,     4,     3,     2,     3,     3,     4,     1,     2,
+       1,     2,     1,     2,     5,     7,     5,     5,     7,     6,
+       7,     3,     2,     2,     2,     3
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, state, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, scanner, state); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ParserState *state)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (state);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ParserState *state)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, state);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, yyscan_t scanner, ParserState *state)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, state);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, state); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner, ParserState *state)
+{
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (state);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
+    {
+    case YYSYMBOL_IDENTIFIER: /* IDENTIFIER  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).string); }
+#line 1427 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_translation_unit: /* translation_unit  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1433 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_external_declaration: /* external_declaration  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).nodes); }
+#line 1439 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_function_definition: /* function_definition  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1445 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_attribute_specifier: /* attribute_specifier  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).string); }
+#line 1451 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_primary_expression: /* primary_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1457 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_postfix_expression: /* postfix_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1463 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_argument_expression_list: /* argument_expression_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).nodes); }
+#line 1469 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_unary_expression: /* unary_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1475 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_unary_operator: /* unary_operator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).string); }
+#line 1481 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_cast_expression: /* cast_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1487 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_multiplicative_expression: /* multiplicative_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1493 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_additive_expression: /* additive_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1499 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_shift_expression: /* shift_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1505 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_relational_expression: /* relational_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1511 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_equality_expression: /* equality_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1517 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_and_expression: /* and_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1523 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_exclusive_or_expression: /* exclusive_or_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1529 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_inclusive_or_expression: /* inclusive_or_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1535 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_logical_and_expression: /* logical_and_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1541 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_logical_or_expression: /* logical_or_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1547 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_conditional_expression: /* conditional_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1553 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_assignment_expression: /* assignment_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1559 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_expression: /* expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1565 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_constant_expression: /* constant_expression  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1571 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_declaration: /* declaration  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1577 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_declaration_specifiers: /* declaration_specifiers  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1583 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_init_declarator_list: /* init_declarator_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).nodes); }
+#line 1589 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_init_declarator: /* init_declarator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1595 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_storage_class_specifier: /* storage_class_specifier  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).string); }
+#line 1601 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_type_specifier: /* type_specifier  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1607 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_struct_specifier: /* struct_specifier  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1613 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_struct_declaration_list: /* struct_declaration_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1619 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_struct_declaration: /* struct_declaration  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1625 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_specifier_qualifier_list: /* specifier_qualifier_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1631 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_struct_declarator_list: /* struct_declarator_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1637 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_struct_declarator: /* struct_declarator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1643 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_enum_specifier: /* enum_specifier  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1649 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_enumerator_list: /* enumerator_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1655 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_enumerator: /* enumerator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1661 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_declarator: /* declarator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1667 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_direct_declarator: /* direct_declarator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1673 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_pointer: /* pointer  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1679 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_parameter_list: /* parameter_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1685 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_parameter_declaration: /* parameter_declaration  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1691 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_identifier_list: /* identifier_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1697 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_type_name: /* type_name  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1703 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_abstract_declarator: /* abstract_declarator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1709 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_direct_abstract_declarator: /* direct_abstract_declarator  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1715 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_initializer: /* initializer  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1721 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_initializer_list: /* initializer_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1727 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_statement: /* statement  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1733 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_labeled_statement: /* labeled_statement  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1739 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_compound_statement: /* compound_statement  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1745 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_declaration_list: /* declaration_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).nodes); }
+#line 1751 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_statement_list: /* statement_list  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).nodes); }
+#line 1757 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_expression_statement: /* expression_statement  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1763 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_selection_statement: /* selection_statement  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1769 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_iteration_statement: /* iteration_statement  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1775 "build/parser.tab.cpp"
+        break;
+
+    case YYSYMBOL_jump_statement: /* jump_statement  */
+#line 95 "src/parser.y"
+            { delete ((*yyvaluep).node); }
+#line 1781 "build/parser.tab.cpp"
+        break;
+
+      default:
+        break;
+    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (yyscan_t scanner, ParserState *state)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* ROOT: translation_unit  */
+#line 102 "src/parser.y"
+                     { state->root = new TranslationUnit((yyvsp[0].node)); }
+#line 2057 "build/parser.tab.cpp"
+    break;
+
+  case 3: /* translation_unit: external_declaration  */
+#line 105 "src/parser.y"
+                               { (yyval.node) = (yyvsp[0].nodes); }
+#line 2063 "build/parser.tab.cpp"
+    break;
+
+  case 5: /* external_declaration: function_definition  */
+#line 110 "src/parser.y"
+                              { (yyval.nodes) = new NodeList(TakeDeclaration(state, (yyvsp[0].node))); }
+#line 2069 "build/parser.tab.cpp"
+    break;
+
+  case 6: /* external_declaration: external_declaration function_definition  */
+#line 111 "src/parser.y"
+                                                   {
+		Node *declaration = TakeDeclaration(state, (yyvsp[0].node));
+		if (declaration != nullptr){
+			(yyvsp[-1].nodes)->PushBack(declaration);
+		}
+		(yyval.nodes)=(yyvsp[-1].nodes);
+	}
+#line 2081 "build/parser.tab.cpp"
+    break;
+
+  case 9: /* function_definition: declaration_specifiers declarator compound_statement  */
+#line 123 "src/parser.y"
+                                                               {
+		(yyval.node) = new FunctionDefinition((yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
+	}
+#line 2089 "build/parser.tab.cpp"
+    break;
+
+  case 12: /* function_definition: declaration_specifiers declarator ';'  */
+#line 128 "src/parser.y"
+                                                { (yyval.node) = new EmptyFunctionDefinition((yyvsp[-2].node), (yyvsp[-1].node)); }
+#line 2095 "build/parser.tab.cpp"
+    break;
+
+  case 13: /* function_definition: declaration_specifiers declarator attribute_specifier ';'  */
+#line 129 "src/parser.y"
+                                                                    {
+		(yyval.node) = new EmptyFunctionDefinition((yyvsp[-3].node), (yyvsp[-2].node), *(yyvsp[-1].string));
+		delete (yyvsp[-1].string);
+	}
+#line 2104 "build/parser.tab.cpp"
+    break;
+
+  case 14: /* function_definition: attribute_specifier declaration_specifiers declarator ';'  */
+#line 133 "src/parser.y"
+                                                                    {
+		(yyval.node) = new EmptyFunctionDefinition((yyvsp[-2].node), (yyvsp[-1].node), *(yyvsp[-3].string));
+		delete (yyvsp[-3].string);
+	}
+#line 2113 "build/parser.tab.cpp"
+    break;
+
+  case 15: /* attribute_specifier: ATTRIBUTE '(' '(' IDENTIFIER ')' ')'  */
+#line 140 "src/parser.y"
+                                               { (yyval.string) = (yyvsp[-2].string); }
+#line 2119 "build/parser.tab.cpp"
+    break;
+
+  case 16: /* attribute_specifier: ATTRIBUTE '(' '(' CONST ')' ')'  */
+#line 141 "src/parser.y"
+                                          { (yyval.string) = new std::string("const"); }
+#line 2125 "build/parser.tab.cpp"
+    break;
+
+  case 17: /* primary_expression: IDENTIFIER  */
+#line 146 "src/parser.y"
+                     {
+       	(yyval.node) = new VariableIdentifier(*(yyvsp[0].string));
+		delete (yyvsp[0].string);
+	}
+#line 2134 "build/parser.tab.cpp"
+    break;
+
+  case 18: /* primary_expression: INT_CONSTANT  */
+#line 150 "src/parser.y"
+                       {
+		(yyval.node) = new IntConstant((yyvsp[0].number_int));
+	}
+#line 2142 "build/parser.tab.cpp"
+    break;
+
+  case 19: /* primary_expression: FLOAT_CONSTANT  */
+#line 153 "src/parser.y"
+                     {
+		(yyval.node) = new FloatConstant((yyvsp[0].number_float));
+	}
+#line 2150 "build/parser.tab.cpp"
+    break;
+
+  case 20: /* primary_expression: STRING_LITERAL  */
+#line 156 "src/parser.y"
+                         {
+		(yyval.node) = new StringConstant((yyvsp[0].number_int));
+	}
+#line 2158 "build/parser.tab.cpp"
+    break;
+
+  case 21: /* primary_expression: '(' expression ')'  */
+#line 159 "src/parser.y"
+                             { (yyval.node) = (yyvsp[-1].node); }
+#line 2164 "build/parser.tab.cpp"
+    break;
+
+  case 22: /* postfix_expression: primary_expression  */
+#line 163 "src/parser.y"
+                             { (yyval.node) = (yyvsp[0].node); }
+#line 2170 "build/parser.tab.cpp"
+    break;
+
+  case 23: /* postfix_expression: postfix_expression '[' expression ']'  */
+#line 164 "src/parser.y"
+                                                { (yyval.node) = new ArrayIndex((yyvsp[-3].node), (yyvsp[-1].node)); }
+#line 2176 "build/parser.tab.cpp"
+    break;
+
+  case 24: /* postfix_expression: postfix_expression '(' ')'  */
+#line 165 "src/parser.y"
+                                     { (yyval.node) = new FunctionCall((yyvsp[-2].node)); }
+#line 2182 "build/parser.tab.cpp"
+    break;
+
+  case 25: /* postfix_expression: postfix_expression '(' argument_expression_list ')'  */
+#line 166 "src/parser.y"
+                                                              { (yyval.node) = new FunctionCallWithArguments((yyvsp[-3].node), (yyvsp[-1].nodes)); }
+#line 2188 "build/parser.tab.cpp"
+    break;
+
+  case 28: /* postfix_expression: postfix_expression INC_OP  */
+#line 169 "src/parser.y"
+                                    { (yyval.node) = new IncrementExpression((yyvsp[-1].node), 1, false); }
+#line 2194 "build/parser.tab.cpp"
+    break;
+
+  case 29: /* postfix_expression: postfix_expression DEC_OP  */
+#line 170 "src/parser.y"
+                                    { (yyval.node) = new IncrementExpression((yyvsp[-1].node), -1, false); }
+#line 2200 "build/parser.tab.cpp"
+    break;
+
+  case 30: /* argument_expression_list: assignment_expression  */
+#line 174 "src/parser.y"
+                                { (yyval.nodes) = new NodeList((yyvsp[0].node)); }
+#line 2206 "build/parser.tab.cpp"
+    break;
+
+  case 31: /* argument_expression_list: argument_expression_list ',' assignment_expression  */
+#line 175 "src/parser.y"
+                                                             { (yyvsp[-2].nodes)->PushBack((yyvsp[0].node)); (yyval.nodes) = (yyvsp[-2].nodes); }
+#line 2212 "build/parser.tab.cpp"
+    break;
+
+  case 32: /* unary_expression: postfix_expression  */
+#line 179 "src/parser.y"
+                             { (yyval.node) = (yyvsp[0].node); }
+#line 2218 "build/parser.tab.cpp"
+    break;
+
+  case 33: /* unary_expression: INC_OP unary_expression  */
+#line 180 "src/parser.y"
+                                  { (yyval.node) = new IncrementExpression((yyvsp[0].node), 1, true); }
+#line 2224 "build/parser.tab.cpp"
+    break;
+
+  case 34: /* unary_expression: DEC_OP unary_expression  */
+#line 181 "src/parser.y"
+                                  { (yyval.node) = new IncrementExpression((yyvsp[0].node), -1, true); }
+#line 2230 "build/parser.tab.cpp"
+    break;
+
+  case 36: /* unary_expression: SIZEOF unary_expression  */
+#line 183 "src/parser.y"
+                                  { (yyval.node) = new SizeOfVariable((yyvsp[0].node)); }
+#line 2236 "build/parser.tab.cpp"
+    break;
+
+  case 37: /* unary_expression: SIZEOF '(' type_name ')'  */
+#line 184 "src/parser.y"
+                                   { (yyval.node) = new SizeOfType((yyvsp[-1].node)); }
+#line 2242 "build/parser.tab.cpp"
+    break;
+
+  case 44: /* cast_expression: unary_expression  */
+#line 197 "src/parser.y"
+                           { (yyval.node) = (yyvsp[0].node); }
+#line 2248 "build/parser.tab.cpp"
+    break;
+
+  case 46: /* multiplicative_expression: cast_expression  */
+#line 202 "src/parser.y"
+                          { (yyval.node) = (yyvsp[0].node); }
+#line 2254 "build/parser.tab.cpp"
+    break;
+
+  case 47: /* multiplicative_expression: multiplicative_expression '*' cast_expression  */
+#line 203 "src/parser.y"
+                                                        { (yyval.node) = new MulOperation((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2260 "build/parser.tab.cpp"
+    break;
+
+  case 48: /* multiplicative_expression: multiplicative_expression '/' cast_expression  */
+#line 204 "src/parser.y"
+                                                        { (yyval.node) = new DivOperation((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2266 "build/parser.tab.cpp"
+    break;
+
+  case 49: /* multiplicative_expression: multiplicative_expression '%' cast_expression  */
+#line 205 "src/parser.y"
+                                                        { (yyval.node) = new ModuloOperation((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2272 "build/parser.tab.cpp"
+    break;
+
+  case 50: /* additive_expression: multiplicative_expression  */
+#line 209 "src/parser.y"
+                                    { (yyval.node) = (yyvsp[0].node); }
+#line 2278 "build/parser.tab.cpp"
+    break;
+
+  case 51: /* additive_expression: additive_expression '+' multiplicative_expression  */
+#line 210 "src/parser.y"
+                                                            { (yyval.node) = new AddOperation((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2284 "build/parser.tab.cpp"
+    break;
+
+  case 52: /* additive_expression: additive_expression '-' multiplicative_expression  */
+#line 211 "src/parser.y"
+                                                            { (yyval.node) = new SubOperation((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2290 "build/parser.tab.cpp"
+    break;
+
+  case 53: /* shift_expression: additive_expression  */
+#line 215 "src/parser.y"
+                              { (yyval.node) = (yyvsp[0].node); }
+#line 2296 "build/parser.tab.cpp"
+    break;
+
+  case 54: /* shift_expression: shift_expression LEFT_OP additive_expression  */
+#line 216 "src/parser.y"
+                                                       { (yyval.node) = new ShiftLeft((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2302 "build/parser.tab.cpp"
+    break;
+
+  case 55: /* shift_expression: shift_expression RIGHT_OP additive_expression  */
+#line 217 "src/parser.y"
+                                                        { (yyval.node) = new ShiftRight((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2308 "build/parser.tab.cpp"
+    break;
+
+  case 56: /* relational_expression: shift_expression  */
+#line 221 "src/parser.y"
+                           { (yyval.node) = (yyvsp[0].node); }
+#line 2314 "build/parser.tab.cpp"
+    break;
+
+  case 57: /* relational_expression: relational_expression '<' shift_expression  */
+#line 222 "src/parser.y"
+                                                     {(yyval.node) = new LessThan((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2320 "build/parser.tab.cpp"
+    break;
+
+  case 58: /* relational_expression: relational_expression '>' shift_expression  */
+#line 223 "src/parser.y"
+                                                     {(yyval.node) = new GreaterThan((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2326 "build/parser.tab.cpp"
+    break;
+
+  case 59: /* relational_expression: relational_expression LE_OP shift_expression  */
+#line 224 "src/parser.y"
+                                                       {(yyval.node) = new LessThanEqual((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2332 "build/parser.tab.cpp"
+    break;
+
+  case 60: /* relational_expression: relational_expression GE_OP shift_expression  */
+#line 225 "src/parser.y"
+                                                       {(yyval.node) = new GreaterThanEqual((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2338 "build/parser.tab.cpp"
+    break;
+
+  case 61: /* equality_expression: relational_expression  */
+#line 229 "src/parser.y"
+                                { (yyval.node)=(yyvsp[0].node); }
+#line 2344 "build/parser.tab.cpp"
+    break;
+
+  case 62: /* equality_expression: equality_expression EQ_OP relational_expression  */
+#line 230 "src/parser.y"
+                                                          {(yyval.node)= new Equal((yyvsp[-2].node),(yyvsp[0].node));}
+#line 2350 "build/parser.tab.cpp"
+    break;
+
+  case 63: /* equality_expression: equality_expression NE_OP relational_expression  */
+#line 231 "src/parser.y"
+                                                          {(yyval.node)= new NotEqual((yyvsp[-2].node),(yyvsp[0].node));}
+#line 2356 "build/parser.tab.cpp"
+    break;
+
+  case 64: /* and_expression: equality_expression  */
+#line 235 "src/parser.y"
+                              { (yyval.node) = (yyvsp[0].node); }
+#line 2362 "build/parser.tab.cpp"
+    break;
+
+  case 65: /* and_expression: and_expression '&' equality_expression  */
+#line 236 "src/parser.y"
+                                                 {(yyval.node) = new BitwiseAnd((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2368 "build/parser.tab.cpp"
+    break;
+
+  case 66: /* exclusive_or_expression: and_expression  */
+#line 240 "src/parser.y"
+                         { (yyval.node) = (yyvsp[0].node); }
+#line 2374 "build/parser.tab.cpp"
+    break;
+
+  case 67: /* exclusive_or_expression: exclusive_or_expression '^' and_expression  */
+#line 241 "src/parser.y"
+                                                     {(yyval.node) = new BitwiseXOR((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2380 "build/parser.tab.cpp"
+    break;
+
+  case 68: /* inclusive_or_expression: exclusive_or_expression  */
+#line 245 "src/parser.y"
+                                  { (yyval.node) = (yyvsp[0].node); }
+#line 2386 "build/parser.tab.cpp"
+    break;
+
+  case 69: /* inclusive_or_expression: inclusive_or_expression '|' exclusive_or_expression  */
+#line 246 "src/parser.y"
+                                                              {(yyval.node) = new BitwiseOr((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2392 "build/parser.tab.cpp"
+    break;
+
+  case 70: /* logical_and_expression: inclusive_or_expression  */
+#line 250 "src/parser.y"
+                                  { (yyval.node) = (yyvsp[0].node); }
+#line 2398 "build/parser.tab.cpp"
+    break;
+
+  case 71: /* logical_and_expression: logical_and_expression AND_OP inclusive_or_expression  */
+#line 251 "src/parser.y"
+                                                                { (yyval.node) = new LogicalAnd((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2404 "build/parser.tab.cpp"
+    break;
+
+  case 72: /* logical_or_expression: logical_and_expression  */
+#line 255 "src/parser.y"
+                                 { (yyval.node) = (yyvsp[0].node); }
+#line 2410 "build/parser.tab.cpp"
+    break;
+
+  case 73: /* logical_or_expression: logical_or_expression OR_OP logical_and_expression  */
+#line 256 "src/parser.y"
+                                                             { (yyval.node) = new LogicalOr((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2416 "build/parser.tab.cpp"
+    break;
+
+  case 74: /* conditional_expression: logical_or_expression  */
+#line 261 "src/parser.y"
+                                { (yyval.node) = (yyvsp[0].node); }
+#line 2422 "build/parser.tab.cpp"
+    break;
+
+  case 76: /* assignment_expression: conditional_expression  */
+#line 266 "src/parser.y"
+                                 { (yyval.node) = (yyvsp[0].node); }
+#line 2428 "build/parser.tab.cpp"
+    break;
+
+  case 77: /* assignment_expression: unary_expression '=' assignment_expression  */
+#line 267 "src/parser.y"
+                                                      { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2434 "build/parser.tab.cpp"
+    break;
+
+  case 78: /* assignment_expression: unary_expression ADD_ASSIGN assignment_expression  */
+#line 268 "src/parser.y"
+                                                            { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new AddOperation((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2440 "build/parser.tab.cpp"
+    break;
+
+  case 79: /* assignment_expression: unary_expression SUB_ASSIGN assignment_expression  */
+#line 269 "src/parser.y"
+                                                            { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new SubOperation((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2446 "build/parser.tab.cpp"
+    break;
+
+  case 80: /* assignment_expression: unary_expression MUL_ASSIGN assignment_expression  */
+#line 270 "src/parser.y"
+                                                            { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new MulOperation((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2452 "build/parser.tab.cpp"
+    break;
+
+  case 81: /* assignment_expression: unary_expression DIV_ASSIGN assignment_expression  */
+#line 271 "src/parser.y"
+                                                            { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new DivOperation((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2458 "build/parser.tab.cpp"
+    break;
+
+  case 82: /* assignment_expression: unary_expression MOD_ASSIGN assignment_expression  */
+#line 272 "src/parser.y"
+                                                            { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new ModuloOperation((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2464 "build/parser.tab.cpp"
+    break;
+
+  case 83: /* assignment_expression: unary_expression LEFT_ASSIGN assignment_expression  */
+#line 273 "src/parser.y"
+                                                             { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new ShiftLeft((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2470 "build/parser.tab.cpp"
+    break;
+
+  case 84: /* assignment_expression: unary_expression RIGHT_ASSIGN assignment_expression  */
+#line 274 "src/parser.y"
+                                                              { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new ShiftRight((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2476 "build/parser.tab.cpp"
+    break;
+
+  case 85: /* assignment_expression: unary_expression AND_ASSIGN assignment_expression  */
+#line 275 "src/parser.y"
+                                                            { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new BitwiseAnd((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2482 "build/parser.tab.cpp"
+    break;
+
+  case 86: /* assignment_expression: unary_expression OR_ASSIGN assignment_expression  */
+#line 276 "src/parser.y"
+                                                           { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new BitwiseOr((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2488 "build/parser.tab.cpp"
+    break;
+
+  case 87: /* assignment_expression: unary_expression XOR_ASSIGN assignment_expression  */
+#line 277 "src/parser.y"
+                                                            { (yyval.node) = new VariableAssignExpression((yyvsp[-2].node), new BitwiseXOR((yyvsp[-2].node), (yyvsp[0].node))); }
+#line 2494 "build/parser.tab.cpp"
+    break;
+
+  case 88: /* expression: assignment_expression  */
+#line 295 "src/parser.y"
+                                { (yyval.node) = (yyvsp[0].node); }
+#line 2500 "build/parser.tab.cpp"
+    break;
+
+  case 90: /* constant_expression: conditional_expression  */
+#line 300 "src/parser.y"
+                                 { (yyval.node) = (yyvsp[0].node); }
+#line 2506 "build/parser.tab.cpp"
+    break;
+
+  case 92: /* declaration: declaration_specifiers init_declarator_list ';'  */
+#line 305 "src/parser.y"
+                                                          { (yyval.node) = new MultiDeclarator((yyvsp[-2].node), (yyvsp[-1].nodes)); }
+#line 2512 "build/parser.tab.cpp"
+    break;
+
+  case 93: /* declaration_specifiers: storage_class_specifier  */
+#line 309 "src/parser.y"
+                                  {
+		(yyval.node) = new StorageClassSpecifier(*(yyvsp[0].string), new TypeSpecifier("int"));
+		delete (yyvsp[0].string);
+	}
+#line 2521 "build/parser.tab.cpp"
+    break;
+
+  case 94: /* declaration_specifiers: storage_class_specifier declaration_specifiers  */
+#line 313 "src/parser.y"
+                                                         {
+		(yyval.node) = new StorageClassSpecifier(*(yyvsp[-1].string), (yyvsp[0].node));
+		delete (yyvsp[-1].string);
+	}
+#line 2530 "build/parser.tab.cpp"
+    break;
+
+  case 95: /* declaration_specifiers: type_specifier  */
+#line 317 "src/parser.y"
+                         { (yyval.node) = (yyvsp[0].node); }
+#line 2536 "build/parser.tab.cpp"
+    break;
+
+  case 97: /* init_declarator_list: init_declarator  */
+#line 322 "src/parser.y"
+                          { (yyval.nodes) = new NodeList((yyvsp[0].node)); }
+#line 2542 "build/parser.tab.cpp"
+    break;
+
+  case 98: /* init_declarator_list: init_declarator_list ',' init_declarator  */
+#line 323 "src/parser.y"
+                                                   { (yyvsp[-2].nodes)->PushBack((yyvsp[0].node)); (yyval.nodes)=(yyvsp[-2].nodes); }
+#line 2548 "build/parser.tab.cpp"
+    break;
+
+  case 99: /* init_declarator: declarator  */
+#line 327 "src/parser.y"
+                     { (yyval.node) = new VariableDeclarator((yyvsp[0].node),nullptr); }
+#line 2554 "build/parser.tab.cpp"
+    break;
+
+  case 100: /* init_declarator: declarator '=' initializer  */
+#line 328 "src/parser.y"
+                                     {
+		(yyval.node) = new VariableDeclarator((yyvsp[-2].node),(yyvsp[0].node));
+	}
+#line 2562 "build/parser.tab.cpp"
+    break;
+
+  case 101: /* storage_class_specifier: TYPEDEF  */
+#line 334 "src/parser.y"
+                  { (yyval.string) = new std::string("typedef"); }
+#line 2568 "build/parser.tab.cpp"
+    break;
+
+  case 102: /* storage_class_specifier: EXTERN  */
+#line 335 "src/parser.y"
+                 { (yyval.string) = new std::string("extern"); }
+#line 2574 "build/parser.tab.cpp"
+    break;
+
+  case 103: /* storage_class_specifier: STATIC  */
+#line 336 "src/parser.y"
+                 { (yyval.string) = new std::string("static"); }
+#line 2580 "build/parser.tab.cpp"
+    break;
+
+  case 104: /* storage_class_specifier: AUTO  */
+#line 337 "src/parser.y"
+               { (yyval.string) = new std::string("auto"); }
+#line 2586 "build/parser.tab.cpp"
+    break;
+
+  case 105: /* storage_class_specifier: REGISTER  */
+#line 338 "src/parser.y"
+                   { (yyval.string) = new std::string("register"); }
+#line 2592 "build/parser.tab.cpp"
+    break;
+
+  case 106: /* type_specifier: VOID  */
+#line 342 "src/parser.y"
+               {
+		(yyval.node) = new TypeSpecifier("void");
+	}
+#line 2600 "build/parser.tab.cpp"
+    break;
+
+  case 107: /* type_specifier: CHAR  */
+#line 345 "src/parser.y"
+               {
+		(yyval.node) = new TypeSpecifier("char");
+	}
+#line 2608 "build/parser.tab.cpp"
+    break;
+
+  case 108: /* type_specifier: SHORT  */
+#line 348 "src/parser.y"
+                {
+		(yyval.node) = new TypeSpecifier("short");
+	}
+#line 2616 "build/parser.tab.cpp"
+    break;
+
+  case 109: /* type_specifier: INT  */
+#line 351 "src/parser.y"
+              {
+		(yyval.node) = new TypeSpecifier("int");
+	}
+#line 2624 "build/parser.tab.cpp"
+    break;
+
+  case 110: /* type_specifier: LONG  */
+#line 354 "src/parser.y"
+               {
+		(yyval.node) = new TypeSpecifier("long");
+	}
+#line 2632 "build/parser.tab.cpp"
+    break;
+
+  case 111: /* type_specifier: FLOAT  */
+#line 357 "src/parser.y"
+                {
+		(yyval.node) = new TypeSpecifier("float");
+	}
+#line 2640 "build/parser.tab.cpp"
+    break;
+
+  case 112: /* type_specifier: DOUBLE  */
+#line 360 "src/parser.y"
+                 {
+		(yyval.node) = new TypeSpecifier("double");
+	}
+#line 2648 "build/parser.tab.cpp"
+    break;
+
+  case 113: /* type_specifier: SIGNED  */
+#line 363 "src/parser.y"
+                 {
+		(yyval.node) = new TypeSpecifier("signed");
+	}
+#line 2656 "build/parser.tab.cpp"
+    break;
+
+  case 114: /* type_specifier: UNSIGNED  */
+#line 366 "src/parser.y"
+                   {
+		(yyval.node) = new TypeSpecifier("unsigned");
+	}
+#line 2664 "build/parser.tab.cpp"
+    break;
+
+  case 125: /* specifier_qualifier_list: type_specifier  */
+#line 391 "src/parser.y"
+                         { (yyval.node) = (yyvsp[0].node); }
+#line 2670 "build/parser.tab.cpp"
+    break;
+
+  case 139: /* declarator: direct_declarator  */
+#line 423 "src/parser.y"
+                            { (yyval.node) = (yyvsp[0].node); }
+#line 2676 "build/parser.tab.cpp"
+    break;
+
+  case 140: /* direct_declarator: IDENTIFIER  */
+#line 427 "src/parser.y"
+                     {
+		(yyval.node) = new FunctionIdentifier(*(yyvsp[0].string)); //function name, pointer to String is owned directly
+        delete (yyvsp[0].string);
+	}
+#line 2685 "build/parser.tab.cpp"
+    break;
+
+  case 142: /* direct_declarator: direct_declarator '[' constant_expression ']'  */
+#line 432 "src/parser.y"
+                                                        { (yyval.node) = new ArrayDeclarator((yyvsp[-3].node), (yyvsp[-1].node)); }
+#line 2691 "build/parser.tab.cpp"
+    break;
+
+  case 143: /* direct_declarator: direct_declarator '[' ']'  */
+#line 433 "src/parser.y"
+                                    { (yyval.node) = new ArrayDeclarator((yyvsp[-2].node), nullptr); }
+#line 2697 "build/parser.tab.cpp"
+    break;
+
+  case 144: /* direct_declarator: direct_declarator '(' parameter_list ')'  */
+#line 434 "src/parser.y"
+                                                   { (yyval.node) = new FunctionWithParamDefinition((yyvsp[-3].node),(yyvsp[-1].node)); }
+#line 2703 "build/parser.tab.cpp"
+    break;
+
+  case 146: /* direct_declarator: direct_declarator '(' ')'  */
+#line 436 "src/parser.y"
+                                    {
+		(yyval.node) = new DirectDeclarator((yyvsp[-2].node)); //no parameters
+	}
+#line 2711 "build/parser.tab.cpp"
+    break;
+
+  case 149: /* parameter_list: parameter_declaration  */
+#line 447 "src/parser.y"
+                                { (yyval.node) = (yyvsp[0].node); }
+#line 2717 "build/parser.tab.cpp"
+    break;
+
+  case 150: /* parameter_list: parameter_list ',' parameter_declaration  */
+#line 448 "src/parser.y"
+                                                   { (yyval.node) = new ParameterList((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2723 "build/parser.tab.cpp"
+    break;
+
+  case 151: /* parameter_declaration: declaration_specifiers declarator  */
+#line 452 "src/parser.y"
+                                            { (yyval.node) = new ParameterDeclarator((yyvsp[-1].node), (yyvsp[0].node)); }
+#line 2729 "build/parser.tab.cpp"
+    break;
+
+  case 156: /* type_name: specifier_qualifier_list  */
+#line 463 "src/parser.y"
+                                   { (yyval.node) = (yyvsp[0].node); }
+#line 2735 "build/parser.tab.cpp"
+    break;
+
+  case 170: /* initializer: assignment_expression  */
+#line 486 "src/parser.y"
+                                { (yyval.node) = (yyvsp[0].node); }
+#line 2741 "build/parser.tab.cpp"
+    break;
+
+  case 176: /* statement: compound_statement  */
+#line 498 "src/parser.y"
+                             { (yyval.node) = (yyvsp[0].node); }
+#line 2747 "build/parser.tab.cpp"
+    break;
+
+  case 177: /* statement: expression_statement  */
+#line 499 "src/parser.y"
+                               { (yyval.node) = (yyvsp[0].node); }
+#line 2753 "build/parser.tab.cpp"
+    break;
+
+  case 178: /* statement: selection_statement  */
+#line 500 "src/parser.y"
+                              { (yyval.node) = (yyvsp[0].node); }
+#line 2759 "build/parser.tab.cpp"
+    break;
+
+  case 179: /* statement: iteration_statement  */
+#line 501 "src/parser.y"
+                              { (yyval.node) = (yyvsp[0].node); }
+#line 2765 "build/parser.tab.cpp"
+    break;
+
+  case 180: /* statement: jump_statement  */
+#line 502 "src/parser.y"
+                         { (yyval.node) = (yyvsp[0].node); }
+#line 2771 "build/parser.tab.cpp"
+    break;
+
+  case 184: /* compound_statement: '{' '}'  */
+#line 512 "src/parser.y"
+                  {
+		(yyval.node) = nullptr;
+	}
+#line 2779 "build/parser.tab.cpp"
+    break;
+
+  case 185: /* compound_statement: '{' statement_list '}'  */
+#line 515 "src/parser.y"
+                                 {
+		(yyval.node) = new CompoundStatement((yyvsp[-1].nodes));
+	}
+#line 2787 "build/parser.tab.cpp"
+    break;
+
+  case 186: /* compound_statement: '{' declaration_list '}'  */
+#line 518 "src/parser.y"
+                                   {
+		(yyval.node) = new CompoundStatement((yyvsp[-1].nodes));
+	}
+#line 2795 "build/parser.tab.cpp"
+    break;
+
+  case 187: /* compound_statement: '{' declaration_list statement_list '}'  */
+#line 521 "src/parser.y"
+                                                   {
+		(yyvsp[-2].nodes)->PushBack((yyvsp[-1].nodes));
+		(yyval.node) = new CompoundStatement((yyvsp[-2].nodes));
+	}
+#line 2804 "build/parser.tab.cpp"
+    break;
+
+  case 188: /* declaration_list: declaration  */
+#line 528 "src/parser.y"
+                      { (yyval.nodes) = new NodeList((yyvsp[0].node)); }
+#line 2810 "build/parser.tab.cpp"
+    break;
+
+  case 189: /* declaration_list: declaration_list declaration  */
+#line 529 "src/parser.y"
+                                       { (yyvsp[-1].nodes)->PushBack((yyvsp[0].node)); (yyval.nodes)=(yyvsp[-1].nodes); }
+#line 2816 "build/parser.tab.cpp"
+    break;
+
+  case 190: /* statement_list: statement  */
+#line 533 "src/parser.y"
+                    { (yyval.nodes) = new NodeList((yyvsp[0].node)); }
+#line 2822 "build/parser.tab.cpp"
+    break;
+
+  case 191: /* statement_list: statement_list statement  */
+#line 534 "src/parser.y"
+                                   { (yyvsp[-1].nodes)->PushBack((yyvsp[0].node));
+								 (yyval.nodes)=(yyvsp[-1].nodes);
+	}
+#line 2830 "build/parser.tab.cpp"
+    break;
+
+  case 193: /* expression_statement: expression ';'  */
+#line 541 "src/parser.y"
+                         { (yyval.node) = (yyvsp[-1].node); }
+#line 2836 "build/parser.tab.cpp"
+    break;
+
+  case 194: /* selection_statement: IF '(' expression ')' statement  */
+#line 545 "src/parser.y"
+                                          { (yyval.node) = new IfStatement((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2842 "build/parser.tab.cpp"
+    break;
+
+  case 195: /* selection_statement: IF '(' expression ')' statement ELSE statement  */
+#line 546 "src/parser.y"
+                                                         { (yyval.node) = new IfElseStatement((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));}
+#line 2848 "build/parser.tab.cpp"
+    break;
+
+  case 196: /* selection_statement: SWITCH '(' expression ')' statement  */
+#line 547 "src/parser.y"
+                                              {(yyval.node)= new SwitchStatement((yyvsp[-2].node), (yyvsp[0].node));}
+#line 2854 "build/parser.tab.cpp"
+    break;
+
+  case 197: /* iteration_statement: WHILE '(' expression ')' statement  */
+#line 551 "src/parser.y"
+                                             { (yyval.node) = new WhileLoop((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 2860 "build/parser.tab.cpp"
+    break;
+
+  case 200: /* iteration_statement: FOR '(' expression_statement expression_statement expression ')' statement  */
+#line 554 "src/parser.y"
+                                                                                     { (yyval.node) = new ForLoop((yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[0].node));}
+#line 2866 "build/parser.tab.cpp"
+    break;
+
+  case 204: /* jump_statement: RETURN ';'  */
+#line 561 "src/parser.y"
+                     {
+		(yyval.node) = new ReturnStatement(nullptr);
+	}
+#line 2874 "build/parser.tab.cpp"
+    break;
+
+  case 205: /* jump_statement: RETURN expression ';'  */
+#line 564 "src/parser.y"
+                                {
+		(yyval.node) = new ReturnStatement((yyvsp[-1].node));
+	}
+#line 2882 "build/parser.tab.cpp"
+    break;
+
+
+#line 2886 "build/parser.tab.cpp"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (scanner, state, YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, scanner, state);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, state);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (scanner, state, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, scanner, state);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, state);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 569 "src/parser.y"
+
+
+void yyerror(yyscan_t scanner, ParserState *state, const char *message)
+{
+  if(state->error.empty()){
+    state->error = std::string("Lexing error: ") + message;
+  }
+}
+
+ParserState ParseAST(std::string file_name, PhaseTiming *lexing, std::function<void(Node *)> declaration)
+{
+  ParserState state;
+  state.lexing = lexing;
+  state.declaration = declaration;
+  FILE *file = fopen(file_name.c_str(), "r");
+  if(file == NULL){
+    state.error = "Couldn't open input file: " + file_name;
+    return state;
+  }
+  yyscan_t scanner;
+  yylex_init_extra(&state, &scanner);
+  yyset_in(file, scanner);
+  yyparse(scanner, &state);
+  yylex_destroy(scanner);
+  fclose(file);
+  return state;
+}
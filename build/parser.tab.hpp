@@ -0,0 +1,165 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED
+# define YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 3 "src/parser.y"
+
+    #include "ast.hpp"
+    #include <memory>
+
+    // The scanner flex makes with %option reentrant
+    typedef void *yyscan_t;
+
+#line 57 "build/parser.tab.hpp"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IDENTIFIER = 258,              /* IDENTIFIER  */
+    INT_CONSTANT = 259,            /* INT_CONSTANT  */
+    FLOAT_CONSTANT = 260,          /* FLOAT_CONSTANT  */
+    STRING_LITERAL = 261,          /* STRING_LITERAL  */
+    PTR_OP = 262,                  /* PTR_OP  */
+    INC_OP = 263,                  /* INC_OP  */
+    DEC_OP = 264,                  /* DEC_OP  */
+    LEFT_OP = 265,                 /* LEFT_OP  */
+    RIGHT_OP = 266,                /* RIGHT_OP  */
+    LE_OP = 267,                   /* LE_OP  */
+    GE_OP = 268,                   /* GE_OP  */
+    EQ_OP = 269,                   /* EQ_OP  */
+    NE_OP = 270,                   /* NE_OP  */
+    AND_OP = 271,                  /* AND_OP  */
+    OR_OP = 272,                   /* OR_OP  */
+    MUL_ASSIGN = 273,              /* MUL_ASSIGN  */
+    DIV_ASSIGN = 274,              /* DIV_ASSIGN  */
+    MOD_ASSIGN = 275,              /* MOD_ASSIGN  */
+    ADD_ASSIGN = 276,              /* ADD_ASSIGN  */
+    SUB_ASSIGN = 277,              /* SUB_ASSIGN  */
+    LEFT_ASSIGN = 278,             /* LEFT_ASSIGN  */
+    RIGHT_ASSIGN = 279,            /* RIGHT_ASSIGN  */
+    AND_ASSIGN = 280,              /* AND_ASSIGN  */
+    XOR_ASSIGN = 281,              /* XOR_ASSIGN  */
+    OR_ASSIGN = 282,               /* OR_ASSIGN  */
+    TYPE_NAME = 283,               /* TYPE_NAME  */
+    TYPEDEF = 284,                 /* TYPEDEF  */
+    EXTERN = 285,                  /* EXTERN  */
+    STATIC = 286,                  /* STATIC  */
+    AUTO = 287,                    /* AUTO  */
+    REGISTER = 288,                /* REGISTER  */
+    SIZEOF = 289,                  /* SIZEOF  */
+    CHAR = 290,                    /* CHAR  */
+    SHORT = 291,                   /* SHORT  */
+    INT = 292,                     /* INT  */
+    LONG = 293,                    /* LONG  */
+    SIGNED = 294,                  /* SIGNED  */
+    UNSIGNED = 295,                /* UNSIGNED  */
+    FLOAT = 296,                   /* FLOAT  */
+    DOUBLE = 297,                  /* DOUBLE  */
+    CONST = 298,                   /* CONST  */
+    VOLATILE = 299,                /* VOLATILE  */
+    VOID = 300,                    /* VOID  */
+    STRUCT = 301,                  /* STRUCT  */
+    UNION = 302,                   /* UNION  */
+    ENUM = 303,                    /* ENUM  */
+    ELLIPSIS = 304,                /* ELLIPSIS  */
+    ATTRIBUTE = 305,               /* ATTRIBUTE  */
+    CASE = 306,                    /* CASE  */
+    DEFAULT = 307,                 /* DEFAULT  */
+    IF = 308,                      /* IF  */
+    ELSE = 309,                    /* ELSE  */
+    SWITCH = 310,                  /* SWITCH  */
+    WHILE = 311,                   /* WHILE  */
+    DO = 312,                      /* DO  */
+    FOR = 313,                     /* FOR  */
+    GOTO = 314,                    /* GOTO  */
+    CONTINUE = 315,                /* CONTINUE  */
+    BREAK = 316,                   /* BREAK  */
+    RETURN = 317                   /* RETURN  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 60 "src/parser.y"
+
+  Node         *node;
+  NodeList     *nodes;
+  int          number_int;
+  double       number_float;
+  std::string  *string;
+  yytokentype  token;
+
+#line 145 "build/parser.tab.hpp"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (yyscan_t scanner, ParserState *state);
+
+/* "%code provides" blocks.  */
+#line 11 "src/parser.y"
+
+    int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner);
+    void yyerror(yyscan_t scanner, ParserState *state, const char *message);
+
+#line 164 "build/parser.tab.hpp"
+
+#endif /* !YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED  */
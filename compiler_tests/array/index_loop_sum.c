@@ -0,0 +1,14 @@
+int f(int n)
+{
+    int i;
+    int x[32];
+    int acc;
+    for(i=0; i<n; i++){
+        x[i]=i*3;
+    }
+    acc=0;
+    for(i=0; i<n; i++){
+        acc=acc+x[i];
+    }
+    return acc+i;
+}
@@ -0,0 +1,7 @@
+
+int f(int n);
+
+int main()
+{
+    return !(f(10)==145);
+}
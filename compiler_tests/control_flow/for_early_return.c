@@ -0,0 +1,12 @@
+int f(int n, int x)
+{
+    int i;
+    for (i = 0; i < n; i++)
+    {
+        if (i * i == x)
+        {
+            return i;
+        }
+    }
+    return 100;
+}
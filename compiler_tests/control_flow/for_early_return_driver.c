@@ -0,0 +1,6 @@
+int f(int n, int x);
+
+int main()
+{
+    return !(f(10, 49)==7 && f(10, 50)==100 && f(0, 0)==100 && f(3, 0)==0);
+}
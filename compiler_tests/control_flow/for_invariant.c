@@ -0,0 +1,10 @@
+int f(int n)
+{
+    int x;
+    int i;
+    x=0;
+    for(i=0; i<n*2; i=i+1){
+        x=x+n+1;
+    }
+    return x;
+}
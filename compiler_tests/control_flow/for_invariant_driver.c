@@ -0,0 +1,7 @@
+
+int f(int n);
+
+int main()
+{
+    return !(f(3)==24);
+}
@@ -0,0 +1,10 @@
+int f()
+{
+    int x;
+    int i;
+    x=0;
+    for(i=0; i<4; i++){
+        x=x+i*2;
+    }
+    return x+i;
+}
@@ -0,0 +1,13 @@
+int f(int n)
+{
+    int x;
+    int i;
+    x=0;
+    for(i=0; i<n; i++){
+        x=x+i;
+    }
+    for(i=10; i>=0; i=i-1){
+        x=x+1;
+    }
+    return x;
+}
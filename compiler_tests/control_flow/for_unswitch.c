@@ -0,0 +1,15 @@
+int f(int n, int mode)
+{
+    int x;
+    int i;
+    x=0;
+    for(i=0; i<n; i++){
+        if (mode) {
+            x=x+i;
+        }
+        else {
+            x=x-1;
+        }
+    }
+    return x;
+}
@@ -0,0 +1,6 @@
+int f(int n, int mode);
+
+int main()
+{
+    return !(f(5, 1)==10 && f(3, 0)==-3);
+}
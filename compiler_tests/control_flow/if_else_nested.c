@@ -0,0 +1,27 @@
+int f(int a, int b, int c)
+{
+    int r;
+    if (a > 0 && b > 0)
+    {
+        if (c == 1)
+        {
+            r = 1;
+        }
+        else
+        {
+            r = 2;
+        }
+    }
+    else
+    {
+        if (c == 2)
+        {
+            r = 3;
+        }
+        else
+        {
+            r = 4;
+        }
+    }
+    return r;
+}
@@ -0,0 +1,6 @@
+int f(int a, int b, int c);
+
+int main()
+{
+    return !(f(1, 1, 1)==1 && f(1, 1, 0)==2 && f(0, 1, 2)==3 && f(1, 0, 5)==4);
+}
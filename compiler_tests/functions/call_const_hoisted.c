@@ -0,0 +1,17 @@
+int twice(int x) __attribute__((const));
+
+int sq(int x)
+{
+    return x * x;
+}
+
+int f(int a, int n)
+{
+    int total = 0;
+    int i;
+    for (i = 0; i < n; i++)
+    {
+        total = total + sq(a) + twice(a) + i;
+    }
+    return total + sq(n) * sq(n);
+}
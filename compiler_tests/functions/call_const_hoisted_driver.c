@@ -0,0 +1,11 @@
+int f(int a, int n);
+
+int twice(int x)
+{
+    return x + x;
+}
+
+int main()
+{
+    return !(f(3, 5)==710 && f(2, 0)==0);
+}
@@ -0,0 +1,15 @@
+int g(int x)
+{
+    return x*2;
+}
+
+int f(int n, int k)
+{
+    int s;
+    int i;
+    s=0;
+    for(i=0; i<n; i++){
+        s=s+g(i)+k*3;
+    }
+    return s;
+}
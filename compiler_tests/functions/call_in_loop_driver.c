@@ -0,0 +1,7 @@
+
+int f(int n, int k);
+
+int main()
+{
+    return !(f(5,1)==35);
+}
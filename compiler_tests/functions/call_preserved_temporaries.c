@@ -0,0 +1,9 @@
+int sq(int x)
+{
+    return x*x;
+}
+
+int f(int a, int b)
+{
+    return a*3 + sq(b) + (a+b)*sq(a);
+}
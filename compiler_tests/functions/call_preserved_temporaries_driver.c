@@ -0,0 +1,7 @@
+
+int f(int a, int b);
+
+int main()
+{
+    return !(f(2,5)==59);
+}
@@ -0,0 +1,24 @@
+int scale(int x, int mode)
+{
+    if (mode == 1)
+    {
+        return x * 2;
+    }
+    return x + 100;
+}
+
+int sum(int n, int k)
+{
+    int total = 0;
+    int i;
+    for (i = 0; i < n; i++)
+    {
+        total = total + i * k;
+    }
+    return total;
+}
+
+int f(int a)
+{
+    return scale(a, 1) + scale(a, 1) + scale(a, 0) + sum(4, a);
+}
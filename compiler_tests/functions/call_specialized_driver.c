@@ -0,0 +1,8 @@
+int f(int a);
+int scale(int x, int mode);
+int sum(int n, int k);
+
+int main()
+{
+    return !(f(3)==133 && scale(5, 1)==10 && sum(3, 2)==6);
+}
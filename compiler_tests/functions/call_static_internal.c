@@ -0,0 +1,27 @@
+static int unused(int x)
+{
+    return x + 1;
+}
+
+static int helper(int x, int mode)
+{
+    if (mode)
+    {
+        return x * 3;
+    }
+    return x;
+}
+
+static int only_folded(int x)
+{
+    return x - 1;
+}
+
+int f(int a)
+{
+    if (0)
+    {
+        return only_folded(a);
+    }
+    return helper(a, 1) + helper(a, 1);
+}
@@ -0,0 +1,6 @@
+int f(int a);
+
+int main()
+{
+    return !(f(4)==24);
+}
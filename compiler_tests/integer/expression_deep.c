@@ -0,0 +1,12 @@
+int f()
+{
+    int a;
+    int b;
+    int c;
+    int d;
+    a=1;
+    b=2;
+    c=3;
+    d=4;
+    return (a+b)*(c-d) + ((a*b)-(c*d))*((a+c)*(b+d)) - (a - 5) + (3 + b) + ((a<<2) & 255);
+}
@@ -1,142 +1,377 @@
 #ifndef ARITHMETIC_OPERATORS_HPP
 #define ARITHMETIC_OPERATORS_HPP
 
+#include <algorithm>
+#include <climits>
+
 #include "node.hpp"
 
-class AddOperation : public Node
+// Common base for operators with two operands. The operand that needs more
+// registers is evaluated first, into destReg, and the other into a fresh
+// register, then the derived class emits the instruction(s) that combine them
+// into destReg. This keeps register use to the Sethi-Ullman number of the
+// expression tree.
+class BinaryOperation : public Node
 {
-private:
+protected:
     Node* leftValue;
     Node* rightValue;
+    std::string symbol;
+
+    // Type the operation is performed in: floating point wins over integer
+    std::string GetOperandType(Context &context) const {
+        std::string leftType = leftValue->GetExpressionType(context);
+        std::string rightType = rightValue->GetExpressionType(context);
+        if (leftType=="double" || rightType=="double"){
+            return "double";
+        }
+        if (leftType=="float" || rightType=="float"){
+            return "float";
+        }
+        return leftType;
+    }
+
+    // Integer operations with a small constant operand use the immediate form
+    // of their instruction, which needs no register for the constant
+    virtual std::string GetImmediateInstruction() const {
+        return "";
+    }
+    virtual bool IsCommutative() const {
+        return false;
+    }
+    bool FitsImmediate(int immediate) const {
+        if (symbol=="<<" || symbol==">>"){
+            return immediate>=0 && immediate<=31;
+        }
+        return immediate>=-2048 && immediate<=2047;
+    }
+    virtual bool GetImmediateOperand(Context &context, Node *&operand, int &immediate) const {
+        if (GetImmediateInstruction()=="" || GetOperandType(context)!="int"){
+            return false;
+        }
+        if (rightValue->GetConstantValue(context, immediate) && FitsImmediate(immediate)){
+            operand = leftValue;
+            return true;
+        }
+        if (IsCommutative() && leftValue->GetConstantValue(context, immediate) && FitsImmediate(immediate)){
+            operand = rightValue;
+            return true;
+        }
+        return false;
+    }
+
+    // The heavier operand goes first. Operands with side effects keep the
+    // source order so that their effects happen left to right.
+    bool EvaluateRightFirst(Context &context) const {
+        if (leftValue->HasSideEffects() || rightValue->HasSideEffects()){
+            return false;
+        }
+        return rightValue->GetRegisterNeed(context) > leftValue->GetRegisterNeed(context);
+    }
+
+    // Evaluate the operator on two known integer operands, as the target would
+    bool FoldValues(int left, int right, int &result) const {
+        if (symbol=="+"){ result = (int)((unsigned)left + (unsigned)right); }
+        else if (symbol=="-"){ result = (int)((unsigned)left - (unsigned)right); }
+        else if (symbol=="*"){ result = (int)((unsigned)left * (unsigned)right); }
+        else if (symbol=="/" || symbol=="%"){
+            if (right==0 || (left==INT_MIN && right==-1)){
+                return false;
+            }
+            result = symbol=="/" ? left / right : left % right;
+        }
+        else if (symbol=="&"){ result = left & right; }
+        else if (symbol=="|"){ result = left | right; }
+        else if (symbol=="^"){ result = left ^ right; }
+        else if (symbol=="<<" || symbol==">>"){
+            if (right<0 || right>31){
+                return false;
+            }
+            result = symbol=="<<" ? (int)((unsigned)left << right) : left >> right;
+        }
+        else if (symbol=="<"){ result = left < right; }
+        else if (symbol=="<="){ result = left <= right; }
+        else if (symbol==">"){ result = left > right; }
+        else if (symbol==">="){ result = left >= right; }
+        else if (symbol=="=="){ result = left == right; }
+        else if (symbol=="!="){ result = left != right; }
+        else if (symbol=="&&"){ result = left && right; }
+        else if (symbol=="||"){ result = left || right; }
+        else{
+            return false;
+        }
+        return true;
+    }
+
 public:
-    AddOperation(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {}
-    ~AddOperation(){
+    BinaryOperation(Node* leftValue_, Node* rightValue_, std::string symbol_) : leftValue(leftValue_), rightValue(rightValue_), symbol(symbol_) {}
+    virtual ~BinaryOperation(){
         delete leftValue;
         delete rightValue;
     }
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
+        if (EmitHoisted(stream, context, destReg)){
+            return;
+        }
+        int value;
+        if (GetConstantValue(context, value)){
+            context.countStatistic("folded constants");
+            stream << "li " << context.getRegisterName(destReg) << ", " << value << std::endl;
+            return;
+        }
+        Node *operand;
+        int immediate;
+        if (GetImmediateOperand(context, operand, immediate)){
+            operand->EmitRISC(stream, context, destReg);
+            stream << GetImmediateInstruction() << " " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << ", " << immediate << std::endl;
+            return;
+        }
 
-        leftValue->EmitRISC(stream, context, leftRegister);
-        rightValue->EmitRISC(stream, context, rightRegister);
+        bool rightFirst = EvaluateRightFirst(context);
+        Node *first = rightFirst ? rightValue : leftValue;
+        Node *second = rightFirst ? leftValue : rightValue;
+        // The first value can wait in destReg, unless evaluating the second
+        // operand makes a call that would overwrite it
+        int firstRegister = second->HasFunctionCall() ? context.findFreeRegister() : destReg;
+        first->EmitRISC(stream, context, firstRegister);
+        int secondRegister = context.findFreeRegister();
+        second->EmitRISC(stream, context, secondRegister);
+        if (rightFirst){
+            EmitOperation(stream, context, destReg, secondRegister, firstRegister);
+        }
+        else{
+            EmitOperation(stream, context, destReg, firstRegister, secondRegister);
+        }
 
-        std::string variableType = context.getVariableType(leftValue->GetIdentifier());
-        if (variableType=="float"){
-            stream<<"fadd.s f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
+        if (firstRegister != destReg){
+            context.freeRegister(firstRegister);
         }
-        else if (variableType=="double"){
-            stream<<"fadd.d f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
+        context.freeRegister(secondRegister);
+    }
+
+    virtual void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const = 0;
+
+    int GetRegisterNeed(Context &context) const {
+        int value;
+        Node *operand;
+        if (context.hoistedRegister(this) != -1 || GetConstantValue(context, value)){
+            return 1;
         }
-        else{
-            stream<<"add "<<context.getRegisterName(destReg)<<", "<<context.getRegisterName(leftRegister)<<", "<<context.getRegisterName(rightRegister)<<std::endl;
+        if (GetImmediateOperand(context, operand, value)){
+            return operand->GetRegisterNeed(context);
+        }
+        int leftNeed = leftValue->GetRegisterNeed(context);
+        int rightNeed = rightValue->GetRegisterNeed(context);
+        if (EvaluateRightFirst(context)){
+            return std::max(rightNeed, leftNeed + 1);
+        }
+        return std::max(leftNeed, rightNeed + 1);
+    }
+
+    std::string GetExpressionType(Context &context) const {
+        return GetOperandType(context);
+    }
+    std::vector<Node *> GetChildren() const {
+        return {leftValue, rightValue};
+    }
+    bool IsHoistable() const {
+        return true;
+    }
+    bool GetConstantValue(Context &context, int &value) const {
+        int left, right;
+        if (GetOperandType(context)!="int"){
+            return false;
         }
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
+        if (!leftValue->GetConstantValue(context, left) || !rightValue->GetConstantValue(context, right)){
+            return false;
+        }
+        return FoldValues(left, right, value);
     }
     void Print(std::ostream &stream) const {
         leftValue->Print(stream);
-        stream<<" + ";
+        stream << " " << symbol << " ";
         rightValue->Print(stream);
     }
 };
 
-class SubOperation : public Node
+// Arithmetic operation that has an integer, single and double precision form
+class ArithmeticOperation : public BinaryOperation
 {
 private:
-    Node* leftValue;
-    Node* rightValue;
+    std::string integerInstruction;
+    std::string floatInstruction;
 public:
-    SubOperation(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {}
-    ~SubOperation(){
-        delete leftValue;
-        delete rightValue;
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
+    ArithmeticOperation(Node* leftValue_, Node* rightValue_, std::string integerInstruction_, std::string floatInstruction_, std::string symbol_)
+        : BinaryOperation(leftValue_, rightValue_, symbol_), integerInstruction(integerInstruction_), floatInstruction(floatInstruction_) {}
 
-        leftValue->EmitRISC(stream, context, leftRegister);
-        rightValue->EmitRISC(stream, context, rightRegister);
-
-        std::string variableType = context.getVariableType(leftValue->GetIdentifier());
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
+        std::string variableType = GetOperandType(context);
         if (variableType=="float"){
-            stream<<"fsub.s f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(rightRegister)<<", f"<<context.getRegisterName(leftRegister)<<std::endl;
+            stream<<floatInstruction<<".s f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
         }
         else if (variableType=="double"){
-            stream<<"fsub.d f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(rightRegister)<<", f"<<context.getRegisterName(leftRegister)<<std::endl;
+            stream<<floatInstruction<<".d f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
         }
         else{
-            stream<<"sub "<<context.getRegisterName(destReg)<<", "<<context.getRegisterName(rightRegister)<<", "<<context.getRegisterName(leftRegister)<<std::endl;
+            stream<<integerInstruction<<" "<<context.getRegisterName(destReg)<<", "<<context.getRegisterName(leftRegister)<<", "<<context.getRegisterName(rightRegister)<<std::endl;
         }
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        leftValue->Print(stream);
-        stream<<" - ";
-        rightValue->Print(stream);
     }
 };
 
+// Operation that only exists on integers
+class IntegerOperation : public BinaryOperation
+{
+private:
+    std::string instruction;
+public:
+    IntegerOperation(Node* leftValue_, Node* rightValue_, std::string instruction_, std::string symbol_)
+        : BinaryOperation(leftValue_, rightValue_, symbol_), instruction(instruction_) {}
 
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
+        stream << instruction << " " << context.getRegisterName(destReg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
+    }
+    std::string GetExpressionType(Context &context) const {
+        return "int";
+    }
+};
 
-class MulOperation : public Node
+class AddOperation : public ArithmeticOperation
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    MulOperation(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {}
-    ~MulOperation(){
-        delete leftValue;
-        delete rightValue;
+    AddOperation(Node* leftValue_, Node* rightValue_) : ArithmeticOperation(leftValue_, rightValue_, "add", "fadd", "+") {}
+
+    std::string GetImmediateInstruction() const {
+        return "addi";
+    }
+    bool IsCommutative() const {
+        return true;
     }
 
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
+    bool GetOffset(Context &context, const std::string &variable, int &offset) const {
+        return leftValue->IsVariable() && leftValue->GetIdentifier()==variable && rightValue->GetConstantValue(context, offset);
+    }
+};
 
-        leftValue->EmitRISC(stream, context, leftRegister);
-        rightValue->EmitRISC(stream, context, rightRegister);
+class SubOperation : public ArithmeticOperation
+{
+public:
+    SubOperation(Node* leftValue_, Node* rightValue_) : ArithmeticOperation(leftValue_, rightValue_, "sub", "fsub", "-") {}
 
-        std::string variableType = context.getVariableType(leftValue->GetIdentifier());
-        if (variableType=="float"){
-            stream<<"fmul.s f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
-        }
-        else if (variableType=="double"){
-            stream<<"fmul.d f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
+    // `x - c` is `x + (-c)`
+    std::string GetImmediateInstruction() const {
+        return "addi";
+    }
+    bool GetImmediateOperand(Context &context, Node *&operand, int &immediate) const {
+        if (GetOperandType(context)!="int" || !rightValue->GetConstantValue(context, immediate) || immediate==INT_MIN || !FitsImmediate(-immediate)){
+            return false;
         }
-        else{
-            stream<<"mul "<<context.getRegisterName(destReg)<<", "<<context.getRegisterName(leftRegister)<<", "<<context.getRegisterName(rightRegister)<<std::endl;
+        operand = leftValue;
+        immediate = -immediate;
+        return true;
+    }
+
+    bool GetOffset(Context &context, const std::string &variable, int &offset) const {
+        if (leftValue->IsVariable() && leftValue->GetIdentifier()==variable && rightValue->GetConstantValue(context, offset)){
+            offset = -offset;
+            return true;
         }
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
+        return false;
     }
-    void Print(std::ostream &stream) const {
-        leftValue->Print(stream);
-        stream<<" * ";
-        rightValue->Print(stream);
+};
+
+class MulOperation : public ArithmeticOperation
+{
+public:
+    MulOperation(Node* leftValue_, Node* rightValue_) : ArithmeticOperation(leftValue_, rightValue_, "mul", "fmul", "*") {}
+};
+
+class DivOperation : public ArithmeticOperation
+{
+public:
+    DivOperation(Node* leftValue_, Node* rightValue_) : ArithmeticOperation(leftValue_, rightValue_, "div", "fdiv", "/") {}
+};
+
+class ModuloOperation : public IntegerOperation
+{
+public:
+    ModuloOperation(Node* leftValue_, Node* rightValue_) : IntegerOperation(leftValue_, rightValue_, "rem", "%") {}
+};
+
+class BitwiseAnd : public IntegerOperation
+{
+public:
+    BitwiseAnd(Node* leftValue_, Node* rightValue_) : IntegerOperation(leftValue_, rightValue_, "and", "&") {}
+
+    std::string GetImmediateInstruction() const {
+        return "andi";
+    }
+    bool IsCommutative() const {
+        return true;
+    }
+};
+
+class BitwiseOr : public IntegerOperation
+{
+public:
+    BitwiseOr(Node* leftValue_, Node* rightValue_) : IntegerOperation(leftValue_, rightValue_, "or", "|") {}
+
+    std::string GetImmediateInstruction() const {
+        return "ori";
+    }
+    bool IsCommutative() const {
+        return true;
     }
 };
 
+class BitwiseXOR : public IntegerOperation
+{
+public:
+    BitwiseXOR(Node* leftValue_, Node* rightValue_) : IntegerOperation(leftValue_, rightValue_, "xor", "^") {}
 
-class LogicalAnd : public Node
+    std::string GetImmediateInstruction() const {
+        return "xori";
+    }
+    bool IsCommutative() const {
+        return true;
+    }
+};
+
+class ShiftLeft : public IntegerOperation
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    LogicalAnd(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {}
-    ~LogicalAnd(){
-        delete leftValue;
-        delete rightValue;
+    ShiftLeft(Node* leftValue_, Node* rightValue_) : IntegerOperation(leftValue_, rightValue_, "sll", "<<") {}
+
+    std::string GetImmediateInstruction() const {
+        return "slli";
+    }
+};
+
+class ShiftRight : public IntegerOperation
+{
+public:
+    ShiftRight(Node* leftValue_, Node* rightValue_) : IntegerOperation(leftValue_, rightValue_, "sra", ">>") {}
+
+    std::string GetImmediateInstruction() const {
+        return "srai";
     }
+};
 
+class LogicalAnd : public BinaryOperation
+{
+public:
+    LogicalAnd(Node* leftValue_, Node* rightValue_) : BinaryOperation(leftValue_, rightValue_, "&&") {}
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        if (EmitHoisted(stream, context, destReg)){
+            return;
+        }
+        int value;
+        if (GetConstantValue(context, value)){
+            context.countStatistic("folded constants");
+            stream << "li " << context.getRegisterName(destReg) << ", " << value << std::endl;
+            return;
+        }
         // Generate labels for the short-circuit evaluation
         std::string trueLabel = context.nameNewBranch();
         std::string falseLabel = context.nameNewBranch();
@@ -166,27 +401,31 @@ public:
         // End label
         stream << endLabel << ":" << std::endl;
     }
-    void Print(std::ostream &stream) const {
-        leftValue->Print(stream);
-        stream<<" && ";
-        rightValue->Print(stream);
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {}
+    // Both operands are evaluated into destReg in turn
+    int GetRegisterNeed(Context &context) const {
+        return std::max(leftValue->GetRegisterNeed(context), rightValue->GetRegisterNeed(context));
+    }
+    std::string GetExpressionType(Context &context) const {
+        return "int";
     }
 };
 
-class LogicalOr : public Node
+class LogicalOr : public BinaryOperation
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    LogicalOr(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {}
-    ~LogicalOr(){
-        delete leftValue;
-        delete rightValue;
-    }
-
+    LogicalOr(Node* leftValue_, Node* rightValue_) : BinaryOperation(leftValue_, rightValue_, "||") {}
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        if (EmitHoisted(stream, context, destReg)){
+            return;
+        }
+        int value;
+        if (GetConstantValue(context, value)){
+            context.countStatistic("folded constants");
+            stream << "li " << context.getRegisterName(destReg) << ", " << value << std::endl;
+            return;
+        }
         // Generate labels for the short-circuit evaluation
         std::string trueLabel = context.nameNewBranch();
         std::string falseLabel = context.nameNewBranch();
@@ -216,471 +455,100 @@ public:
         // End label
         stream << endLabel << ":" << std::endl;
     }
-    void Print(std::ostream &stream) const {
-        leftValue->Print(stream);
-        stream<<" || ";
-        rightValue->Print(stream);
-    }
-};
-
-
-
-class BitwiseXOR : public Node
-{
-private:
-    Node* leftValue;
-    Node* rightValue;
-public:
-    BitwiseXOR(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~BitwiseXOR(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "xor " << context.getRegisterName(destReg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " ^ ";
-        branches[1]->Print(stream);
-    }
-};
-
-class ShiftLeft : public Node
-{
-private:
-    Node* leftValue;
-    Node* rightValue;
-public:
-    ShiftLeft(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~ShiftLeft(){
-        for (auto branch : branches){
-            delete branch;
-        }
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {}
+    // Both operands are evaluated into destReg in turn
+    int GetRegisterNeed(Context &context) const {
+        return std::max(leftValue->GetRegisterNeed(context), rightValue->GetRegisterNeed(context));
     }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "sll " << context.getRegisterName(destReg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " << ";
-        branches[1]->Print(stream);
+    std::string GetExpressionType(Context &context) const {
+        return "int";
     }
 };
 
-class ShiftRight : public Node
+// Comparisons produce an integer 0 or 1 whatever the type of their operands
+class Comparison : public BinaryOperation
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    ShiftRight(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
+    Comparison(Node* leftValue_, Node* rightValue_, std::string symbol_) : BinaryOperation(leftValue_, rightValue_, symbol_) {}
+    std::string GetExpressionType(Context &context) const {
+        return "int";
     }
-    ~ShiftRight(){
-        for (auto branch : branches){
-            delete branch;
+    bool GetLoopBound(std::string &variable, std::string &comparison, Node *&bound) const {
+        if (!leftValue->IsVariable()){
+            return false;
         }
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "slr " << context.getRegisterName(destReg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " << ";
-        branches[1]->Print(stream);
+        variable = leftValue->GetIdentifier();
+        comparison = symbol;
+        bound = rightValue;
+        return true;
     }
 };
 
-class DivOperation : public Node
+class LessThan : public Comparison
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    DivOperation(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {}
-    ~DivOperation(){
-        delete leftValue;
-        delete rightValue;
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-
-        leftValue->EmitRISC(stream, context, leftRegister);
-        rightValue->EmitRISC(stream, context, rightRegister);
-
-        std::string variableType = context.getVariableType(leftValue->GetIdentifier());
-        if (variableType=="float"){
-            stream<<"fdiv.s f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(rightRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
-        }
-        else if (variableType=="double"){
-            stream<<"fdiv.d f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(leftRegister)<<std::endl;
-        }
-        else{
-            stream<<"div "<<context.getRegisterName(destReg)<<", "<<context.getRegisterName(rightRegister)<<", "<<context.getRegisterName(leftRegister)<<std::endl;
-        }
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        leftValue->Print(stream);
-        stream<<" / ";
-        rightValue->Print(stream);
-    }
-};
-
-class ModuloOperation : public Node
-{
-private:
-    Node* leftValue;
-    Node* rightValue;
-public:
-    ModuloOperation(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {}
-    ~ModuloOperation(){
-        delete leftValue;
-        delete rightValue;
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-
-        leftValue->EmitRISC(stream, context, leftRegister);
-        rightValue->EmitRISC(stream, context, rightRegister);
-
-        std::string variableType = context.getVariableType(leftValue->GetIdentifier());
-        if (variableType=="float"){
-            stream<<"frem.s f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
-        }
-        else if (variableType=="double"){
-            stream<<"frem.d f"<<context.getRegisterName(destReg)<<", f"<<context.getRegisterName(leftRegister)<<", f"<<context.getRegisterName(rightRegister)<<std::endl;
-        }
-        else{
-            stream<<"rem "<<context.getRegisterName(destReg)<<", "<<context.getRegisterName(leftRegister)<<", "<<context.getRegisterName(rightRegister)<<std::endl;
-        }
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        leftValue->Print(stream);
-        stream<<" % ";
-        rightValue->Print(stream);
-    }
-};
-
-class LessThan : public Node
-{
-private:
-    Node* leftValue;
-    Node* rightValue;
-public:
-    LessThan(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~LessThan(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        branches[0]->EmitRISC(stream, context, leftRegister);
-
-
-        stream << "slt " <<context.getRegisterName(leftRegister)<<", " <<context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
-        stream << "andi "<<context.getRegisterName(destReg)<< ", " <<context.getRegisterName(leftRegister)<<", 0xff"<<std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " < ";
-        branches[1]->Print(stream);
-    }
-};
-
-
-class LessThanEqual : public Node
-{
-private:
-    Node* leftValue;
-    Node* rightValue;
-public:
-    LessThanEqual(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~LessThanEqual(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-        int tempreg = context.findFreeRegister();
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "slt " << context.getRegisterName(tempreg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
-        stream << "xori " << context.getRegisterName(tempreg) << ", " << context.getRegisterName(tempreg) << ", 1" << std::endl;
-        stream << "sub " << context.getRegisterName(destReg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
-        stream << "seqz " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << std::endl;
-        stream << "or " << context.getRegisterName(destReg)<< ", "<< context.getRegisterName(destReg) << ", " <<context.getRegisterName(tempreg)<<std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-        context.freeRegister(tempreg);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " <= ";
-        branches[1]->Print(stream);
-    }
-};
-
-class GreaterThan : public Node
-{
-private:
-    Node* leftValue;
-    Node* rightValue;
-public:
-    GreaterThan(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~GreaterThan(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        branches[0]->EmitRISC(stream, context, leftRegister);
-
+    LessThan(Node* leftValue_, Node* rightValue_) : Comparison(leftValue_, rightValue_, "<") {}
 
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
         stream << "slt " <<context.getRegisterName(leftRegister)<<", " <<context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
         stream << "andi "<<context.getRegisterName(destReg)<< ", " <<context.getRegisterName(leftRegister)<<", 0xff"<<std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " > ";
-        branches[1]->Print(stream);
     }
 };
 
-
-class GreaterThanEqual : public Node
+class LessThanEqual : public Comparison
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    GreaterThanEqual(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~GreaterThanEqual(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
+    LessThanEqual(Node* leftValue_, Node* rightValue_) : Comparison(leftValue_, rightValue_, "<=") {}
 
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-        int tempreg = context.findFreeRegister();
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "slt " << context.getRegisterName(tempreg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
-        stream << "xori " << context.getRegisterName(tempreg) << ", " << context.getRegisterName(tempreg) << ", 1" << std::endl;
-        stream << "sub " << context.getRegisterName(destReg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
-        stream << "seqz " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << std::endl;
-        stream << "or " << context.getRegisterName(destReg)<< ", "<< context.getRegisterName(destReg) << ", " <<context.getRegisterName(tempreg)<<std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-        context.freeRegister(tempreg);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " >= ";
-        branches[1]->Print(stream);
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
+        // a <= b is !(b < a)
+        stream << "slt " << context.getRegisterName(destReg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
+        stream << "xori " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << ", 1" << std::endl;
     }
 };
 
-class BitwiseAnd : public Node
+class GreaterThan : public Comparison
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    BitwiseAnd(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~BitwiseAnd(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
+    GreaterThan(Node* leftValue_, Node* rightValue_) : Comparison(leftValue_, rightValue_, ">") {}
 
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "and " << context.getRegisterName(destReg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " & ";
-        branches[1]->Print(stream);
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
+        stream << "slt " <<context.getRegisterName(leftRegister)<<", " <<context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
+        stream << "andi "<<context.getRegisterName(destReg)<< ", " <<context.getRegisterName(leftRegister)<<", 0xff"<<std::endl;
     }
 };
 
-class BitwiseOr : public Node
+class GreaterThanEqual : public Comparison
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    BitwiseOr(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~BitwiseOr(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
+    GreaterThanEqual(Node* leftValue_, Node* rightValue_) : Comparison(leftValue_, rightValue_, ">=") {}
 
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "or " << context.getRegisterName(destReg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " | ";
-        branches[1]->Print(stream);
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
+        // a >= b is !(a < b)
+        stream << "slt " << context.getRegisterName(destReg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
+        stream << "xori " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << ", 1" << std::endl;
     }
 };
 
-class Equal : public Node
+class Equal : public Comparison
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    Equal(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~Equal(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
-
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
+    Equal(Node* leftValue_, Node* rightValue_) : Comparison(leftValue_, rightValue_, "==") {}
 
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "sub " << context.getRegisterName(destReg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
+        stream << "sub " << context.getRegisterName(destReg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
         stream << "seqz " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " == ";
-        branches[1]->Print(stream);
     }
 };
 
-
-
-class NotEqual : public Node
+class NotEqual : public Comparison
 {
-private:
-    Node* leftValue;
-    Node* rightValue;
 public:
-    NotEqual(Node* leftValue_, Node* rightValue_) : leftValue(leftValue_), rightValue(rightValue_) {
-        branches.push_back(leftValue);
-        branches.push_back(rightValue);
-    }
-    ~NotEqual(){
-        for (auto branch : branches){
-            delete branch;
-        }
-    }
+    NotEqual(Node* leftValue_, Node* rightValue_) : Comparison(leftValue_, rightValue_, "!=") {}
 
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        int leftRegister = context.findFreeRegister();
-        int rightRegister = context.findFreeRegister();
-
-        branches[0]->EmitRISC(stream, context, leftRegister);
-        branches[1]->EmitRISC(stream, context, rightRegister);
-        stream << "sub " << context.getRegisterName(destReg) << ", " << context.getRegisterName(rightRegister) << ", " << context.getRegisterName(leftRegister) << std::endl;
-        stream << "seqz " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << std::endl;
-        stream << "xori " << context.getRegisterName(destReg) <<", "<<context.getRegisterName(destReg)<<", 1"<<std::endl;
-        context.freeRegister(leftRegister);
-        context.freeRegister(rightRegister);
-    }
-    void Print(std::ostream &stream) const {
-        branches[0]->Print(stream);
-        stream << " != ";
-        branches[1]->Print(stream);
+    void EmitOperation(std::ostream &stream, Context &context, int destReg, int leftRegister, int rightRegister) const {
+        stream << "sub " << context.getRegisterName(destReg) << ", " << context.getRegisterName(leftRegister) << ", " << context.getRegisterName(rightRegister) << std::endl;
+        stream << "snez " << context.getRegisterName(destReg) << ", " << context.getRegisterName(destReg) << std::endl;
     }
 };
 
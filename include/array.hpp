@@ -0,0 +1,172 @@
+#ifndef ARRAY_HPP
+#define ARRAY_HPP
+
+#include "node.hpp"
+#include "context.hpp"
+
+// `name[length]` in a declaration
+class ArrayDeclarator : public Node
+{
+private:
+    Node *identifier;
+    Node *length;
+public:
+    ArrayDeclarator(Node* identifier_, Node* length_) : identifier(identifier_), length(length_){}
+
+    virtual ~ArrayDeclarator(){
+        delete identifier;
+        delete length;
+    }
+
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {}
+    void Print(std::ostream &stream) const {
+        identifier->Print(stream);
+        stream<<"[";
+        if (length!=nullptr){
+            length->Print(stream);
+        }
+        stream<<"]";
+    }
+    std::string GetIdentifier() const {
+        return identifier->GetIdentifier();
+    }
+    bool GetArrayLength(Context &context, int &length_) const {
+        return length!=nullptr && length->GetConstantValue(context, length_) && length_>0;
+    }
+    std::vector<Node *> GetChildren() const {
+        return {identifier, length};
+    }
+};
+
+// `array[index]` as an expression or as the target of an assignment
+class ArrayIndex : public Node
+{
+private:
+    Node *array;
+    Node *index;
+
+    int GetElementShift(int elementSize) const {
+        int shift = 0;
+        while ((1 << shift) < elementSize){
+            shift++;
+        }
+        return shift;
+    }
+
+    // Work out the base register and offset addressing the element. When the
+    // address has to be computed it goes in scratchRegister if one is given,
+    // otherwise addressRegister is allocated to hold it and must be freed by
+    // the caller.
+    std::string EmitAddress(std::ostream &stream, Context &context, int &offset, int &addressRegister, int scratchRegister=-1) const {
+        std::string arrayName = array->GetIdentifier();
+        int elementSize = context.getTypeSize(context.getVariableType(arrayName));
+        int location = context.variableLocation(arrayName);
+        addressRegister = -1;
+
+        int indexValue;
+        if (index->GetConstantValue(context, indexValue)){
+            offset = location + indexValue*elementSize;
+            return "s0";
+        }
+        // Indexing by the induction variable of an enclosing loop goes through
+        // the pointer that loop keeps for this array
+        std::string variable;
+        int pointerRegister, lag, indexOffset;
+        if (context.arrayPointer(arrayName, variable, pointerRegister, lag) && index->GetOffset(context, variable, indexOffset)){
+            offset = (indexOffset + lag)*elementSize;
+            return context.getRegisterName(pointerRegister);
+        }
+
+        int indexRegister = scratchRegister;
+        if (indexRegister == -1){
+            addressRegister = context.findFreeRegister();
+            indexRegister = addressRegister;
+        }
+        std::string address = context.getRegisterName(indexRegister);
+        index->EmitRISC(stream, context, indexRegister);
+        int shift = GetElementShift(elementSize);
+        if (shift > 0){
+            stream<<"slli "<<address<<", "<<address<<", "<<shift<<std::endl;
+        }
+        stream<<"add "<<address<<", "<<address<<", s0"<<std::endl;
+        offset = location;
+        return address;
+    }
+
+public:
+    ArrayIndex(Node* array_, Node* index_) : array(array_), index(index_){}
+
+    virtual ~ArrayIndex(){
+        delete array;
+        delete index;
+    }
+
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        if (EmitHoisted(stream, context, destReg)){
+            return;
+        }
+        // Integer loads can compute the address in destReg itself
+        std::string elementType = GetExpressionType(context);
+        bool floatElement = elementType=="float" || elementType=="double";
+        int offset, addressRegister;
+        std::string base = EmitAddress(stream, context, offset, addressRegister, floatElement ? -1 : destReg);
+        EmitLoad(stream, context, elementType, destReg, offset, base);
+        if (addressRegister != -1){
+            context.freeRegister(addressRegister);
+        }
+    }
+    bool EmitElementStore(std::ostream &stream, Context &context, int valueReg) const {
+        int offset, addressRegister;
+        std::string base = EmitAddress(stream, context, offset, addressRegister);
+        EmitStore(stream, context, GetExpressionType(context), valueReg, offset, base);
+        if (addressRegister != -1){
+            context.freeRegister(addressRegister);
+        }
+        return true;
+    }
+    void Print(std::ostream &stream) const {
+        array->Print(stream);
+        stream<<"[";
+        index->Print(stream);
+        stream<<"]";
+    }
+    std::string GetIdentifier() const {
+        return array->GetIdentifier();
+    }
+    std::string GetExpressionType(Context &context) const {
+        return context.getVariableType(array->GetIdentifier());
+    }
+    // The array name is not an expression worth hoisting on its own, so only
+    // the index is walked as a child
+    std::vector<Node *> GetChildren() const {
+        return {index};
+    }
+    void GetReadVariables(std::set<std::string> &variables) const {
+        array->GetReadVariables(variables);
+        index->GetReadVariables(variables);
+    }
+    bool IsHoistable() const {
+        return true;
+    }
+    int GetRegisterNeed(Context &context) const {
+        std::string elementType = GetExpressionType(context);
+        int indexValue;
+        if (context.hoistedRegister(this) != -1 || index->GetConstantValue(context, indexValue)){
+            return 1;
+        }
+        if (elementType=="float" || elementType=="double"){
+            return index->GetRegisterNeed(context) + 1;
+        }
+        return index->GetRegisterNeed(context);
+    }
+    bool GetArrayAccess(std::string &array_, Node *&index_) const {
+        if (!array->IsVariable()){
+            return false;
+        }
+        array_ = array->GetIdentifier();
+        index_ = index;
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef LANGPROC_COMPILER_ASSEMBLY_H
+#define LANGPROC_COMPILER_ASSEMBLY_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// One line of emitted assembly: a label, a directive or an instruction. The
+// AST emits text, which is parsed back into lines so that passes over the
+// machine code can rewrite it before it is written out.
+struct AssemblyLine
+{
+    std::string label;                  // Set for `name:` lines
+    std::string opcode;                 // Instruction mnemonic or directive
+    std::vector<std::string> operands;
+
+    bool isLabel() const;
+    bool isDirective() const;
+    bool isInstruction() const;
+    bool isStore() const;
+    bool isLoad() const;
+    bool isConditionalBranch() const;
+    bool isJump() const;
+    bool isCall() const;
+    bool isReturn() const;
+    // mv, fmv.s or fmv.d between two registers
+    bool isMove() const;
+    // Control leaves the straight-line sequence after this line
+    bool endsBlock() const;
+
+    // Register written by the instruction, or "" if there is none
+    std::string definedRegister() const;
+    // Registers read by the instruction
+    std::vector<std::string> usedRegisters() const;
+    bool uses(const std::string &reg) const;
+    // Read `to` wherever the instruction reads `from`
+    void replaceUses(const std::string &from, const std::string &to);
+    void setDefinedRegister(const std::string &reg);
+    // Label a branch or jump goes to, or "" if there is none
+    std::string target() const;
+    void setTarget(const std::string &label);
+
+    std::string toString() const;
+};
+
+bool IsRegister(const std::string &operand);
+// Registers a callee may overwrite without restoring them: ra, t*, a* and
+// their floating point counterparts
+bool IsCallerSaved(const std::string &reg);
+std::vector<std::string> CallerSavedRegisters();
+// Split `offset(base)` into its two parts, or fail if base is not a register
+bool SplitMemoryOperand(const std::string &operand, std::string &offset, std::string &base);
+// Labels the passes make for branches, L<n> with an optional tag such as
+// LJ<n>, as opposed to function names
+bool IsLocalLabel(const std::string &label);
+// Branch with the opposite condition, or "" if opcode is not a branch
+std::string InvertedBranch(const std::string &opcode);
+
+AssemblyLine MakeInstruction(const std::string &opcode, const std::vector<std::string> &operands);
+std::vector<AssemblyLine> ParseAssembly(std::istream &input);
+void WriteAssembly(std::ostream &output, const std::vector<AssemblyLine> &code);
+
+#endif
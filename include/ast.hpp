@@ -1,6 +1,7 @@
 #ifndef AST_HPP
 #define AST_HPP
 
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -18,7 +19,25 @@
 #include "control_flow.hpp"
 #include "multi_declaration.hpp"
 #include "function_caller.hpp"
+#include "array.hpp"
+#include "compound_statement.hpp"
+#include "translation_unit.hpp"
 
-extern Node *ParseAST(std::string file_name);
+struct PhaseTiming;
+
+// The state of parsing one file, and what came of it
+struct ParserState
+{
+    Node *root = nullptr;           // The translation unit, once parsed
+    std::string error;              // Why there is no root, if there is a reason
+    PhaseTiming *lexing = nullptr;  // Adds up the time spent lexing, if set
+    // If set, takes each top-level declaration as soon as it is parsed, and
+    // owns it from then on. The root is left without them.
+    std::function<void(Node *)> declaration;
+};
+
+// Parse the file. Nothing is shared between calls, so several files can be
+// parsed at once.
+extern ParserState ParseAST(std::string file_name, PhaseTiming *lexing = nullptr, std::function<void(Node *)> declaration = nullptr);
 
 #endif
@@ -0,0 +1,23 @@
+#ifndef LANGPROC_COMPILER_BLOCK_LAYOUT_H
+#define LANGPROC_COMPILER_BLOCK_LAYOUT_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "assembly.h"
+#include "profile.h"
+
+// Position of the first instruction of each basic block of each function
+// the layout pass can handle, in the order the pass numbers them
+std::map<std::string, std::vector<size_t>> FindBasicBlocks(const std::vector<AssemblyLine> &code);
+
+// Reorder the basic blocks of each function so that the likely successor of
+// a branch falls through. Branches back to a loop header are taken to be
+// likely, and edges into a return that skips over the rest of the function
+// unlikely, unless a profile says otherwise. Blocks only reached through
+// unlikely edges, or that never ran, are moved to .text.unlikely, and loop
+// headers are aligned. Returns the number of blocks that moved.
+int RunBlockLayout(std::vector<AssemblyLine> &code, const Profile *profile = nullptr);
+
+#endif
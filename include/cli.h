@@ -2,12 +2,39 @@
 #define LANGPROC_COMPILER_CLI_H
 
 #include <iostream>
+#include <vector>
 #include <unistd.h>
+#include <getopt.h>
+
+// A source file and where its assembly goes
+struct SourceFile
+{
+    std::string source_path;
+    std::string output_path;
+};
 
 struct CommandLineArguments
 {
-    std::string compile_source_path;
+    std::string compile_source_path; // The file being compiled, the first one until a batch starts
     std::string compile_output_path;
+    std::vector<SourceFile> files; // Every -S/-o pair, then every file of the manifest
+    int jobs = 0; // Worker threads compiling the files, 0 for one per core
+    int codegen_threads = 1; // Threads compiling the functions of one file, out of the jobs
+    int unroll_factor = 4;
+    bool peephole = true;
+    bool copy_propagation = true;
+    bool jump_threading = true;
+    bool reorder_blocks = true;
+    bool schedule = true;
+    bool function_sections = true;
+    std::string tune = "dual-issue";
+    bool profile_generate = false;
+    bool profile_use = false;
+    std::string profile_path; // Defaults to the output path with a .profile extension
+    bool time_report = false;
+    bool stats = false;
+    std::string stats_json_path; // Both reports as JSON, if set
+    bool streaming = false; // Compile each function as soon as it is parsed, then free it
 };
 
 CommandLineArguments ParseCommandLineArgs(int argc, char **argv);
@@ -0,0 +1,119 @@
+#ifndef COMPOUND_STATEMENT_HPP
+#define COMPOUND_STATEMENT_HPP
+
+#include <map>
+
+#include "node.hpp"
+
+// `{ ... }`: a block whose declarations are only visible inside it
+class CompoundStatement : public Node
+{
+private:
+    Node *statements;
+
+    // Keep enough temporaries free for the statement itself
+    static const int minFreeRegisters = 4;
+
+    // Calls to const and pure functions made more than once in a statement
+    // with the same arguments, which are constants or variables the statement
+    // does not assign, are evaluated once before it and the copies share the
+    // result. Each group is returned with the register holding its value.
+    std::vector<std::pair<std::vector<const Node*>, int>> EmitCommonCalls(std::ostream &stream, Context &context, const Node *statement) const {
+        std::vector<const Node*> calls;
+        statement->FindCalls(calls);
+        std::set<std::string> writes;
+        statement->GetWrittenVariables(writes);
+        bool writesMemory = statement->CallsFunctionWithSideEffects(context);
+
+        std::map<std::string, std::vector<const Node*>> groups;
+        std::vector<std::string> order;
+        for (auto call : calls){
+            std::string function;
+            std::vector<Node *> arguments;
+            call->GetCall(function, arguments);
+            bool readsMemory = false;
+            if (context.hoistedRegister(call) != -1 || !call->IsRepeatable(context, readsMemory) || (readsMemory && writesMemory)){
+                continue;
+            }
+            std::string key = function;
+            bool simple = true;
+            for (auto argument : arguments){
+                int value;
+                if (argument->GetConstantValue(context, value)){
+                    key += " " + std::to_string(value);
+                }
+                else if (argument->IsVariable() && !writes.count(argument->GetIdentifier())){
+                    key += " " + argument->GetIdentifier();
+                }
+                else{
+                    simple = false;
+                }
+            }
+            if (!simple){
+                continue;
+            }
+            if (groups[key].empty()){
+                order.push_back(key);
+            }
+            groups[key].push_back(call);
+        }
+
+        std::vector<std::pair<std::vector<const Node*>, int>> common;
+        for (auto &key : order){
+            auto &group = groups[key];
+            if (group.size() < 2){
+                continue;
+            }
+            // Other calls in the statement would make a temporary be spilled
+            // around them, so a saved register is used if there is one
+            int reg = -1;
+            if (calls.size() > group.size()){
+                reg = context.findFreeSavedRegister();
+            }
+            if (reg == -1){
+                if (context.countFreeRegisters() <= minFreeRegisters){
+                    break;
+                }
+                reg = context.findFreeRegister();
+            }
+            group.front()->EmitRISC(stream, context, reg);
+            for (auto call : group){
+                context.hoistExpression(call, reg);
+            }
+            common.push_back({group, reg});
+        }
+        return common;
+    }
+
+public:
+    CompoundStatement(Node *statements_) : statements(statements_){}
+    ~CompoundStatement(){
+        delete statements;
+    }
+
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        context.enterScope();
+        for (auto statement : statements->GetChildren()){
+            if (statement == nullptr){
+                continue;
+            }
+            auto common = EmitCommonCalls(stream, context, statement);
+            statement->EmitRISC(stream, context, destReg);
+            for (auto &group : common){
+                context.freeRegister(group.second);
+                for (auto call : group.first){
+                    context.unhoistExpression(call);
+                }
+            }
+        }
+        context.exitScope();
+    }
+    void Print(std::ostream &stream) const {
+        statements->Print(stream);
+    }
+    std::vector<Node *> GetChildren() const {
+        return {statements};
+    }
+};
+
+#endif
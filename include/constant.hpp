@@ -15,6 +15,10 @@ public:
     void Print(std::ostream &stream) const {
         stream << value_;
     }
+    bool GetConstantValue(Context &context, int &value) const {
+        value = value_;
+        return true;
+    }
 };
 
 class FloatConstant : public Node
@@ -30,6 +34,9 @@ public:
     void Print(std::ostream &stream) const {
         stream << value;
     }
+    std::string GetExpressionType(Context &context) const {
+        return "float";
+    }
 };
 
 class StringConstant : public Node
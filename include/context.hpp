@@ -3,6 +3,139 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+class Node;
+
+// What calling a function can do besides returning its result
+enum FunctionEffect
+{
+    CONST_FUNCTION, // The result only depends on the arguments
+    PURE_FUNCTION,  // The result also depends on memory, which is not written
+    SIDE_EFFECTS,
+};
+
+// What is known about the functions of a file, by name. The contexts that
+// compile the file's functions share one table, possibly from several
+// threads at once, so every access takes the lock.
+class SymbolTable
+{
+private:
+    mutable std::shared_mutex mutex;
+    std::vector<std::string> declaredFunctions; // Functions that have been declared (and can be called)
+    std::map<std::string, std::string> functionTypes; // Function name binding to return type
+    std::map<std::string, FunctionEffect> functionEffects; // Functions known to be const or pure
+    std::set<std::string> internalFunctions; // Functions declared static, which other files cannot call
+    std::map<std::string, long long> functionCounts; // Times each function was entered, from -fprofile-use
+
+    // A copy of a function compiled for calls passing the same constant
+    // integer arguments, which are left out of its parameters
+    struct Specialization
+    {
+        std::map<int, int> constants; // Parameter position binding to its value
+        std::string name;
+    };
+    std::map<std::string, std::vector<Specialization>> specializations; // Function name binding to its copies
+
+public:
+    void setFunctionType(std::string functionName, std::string returnType){
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        functionTypes[functionName]=returnType;
+    }
+    std::string getFunctionType(std::string functionName) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto functionIndex = functionTypes.find(functionName);
+        if(functionIndex!=functionTypes.end()){
+            return functionIndex->second;
+        }
+        return "int";
+    }
+
+    void setInternalFunction(std::string functionName){
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        internalFunctions.insert(functionName);
+    }
+    bool isInternalFunction(std::string functionName) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return internalFunctions.count(functionName) > 0;
+    }
+
+    void setFunctionEffect(std::string functionName, FunctionEffect effect){
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        functionEffects[functionName]=effect;
+    }
+    FunctionEffect getFunctionEffect(std::string functionName) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto functionIndex = functionEffects.find(functionName);
+        if(functionIndex!=functionEffects.end()){
+            return functionIndex->second;
+        }
+        return SIDE_EFFECTS;
+    }
+
+    void setFunctionCount(std::string functionName, long long count){
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        functionCounts[functionName]=count;
+    }
+    bool isColdFunction(std::string functionName) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto functionIndex = functionCounts.find(functionName);
+        if(functionIndex==functionCounts.end() || functionIndex->second>0){
+            return false;
+        }
+        std::string copies = functionName + ".constprop.";
+        for(auto copy = functionCounts.lower_bound(copies); copy!=functionCounts.end() && copy->first.compare(0, copies.size(), copies)==0; copy++){
+            if(copy->second>0){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string addSpecialization(std::string functionName, std::map<int, int> constants){
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        std::string name = functionName + ".constprop." + std::to_string(specializations[functionName].size());
+        specializations[functionName].push_back({constants, name});
+        return name;
+    }
+    bool findSpecialization(std::string functionName, const std::map<int, int> &arguments, std::map<int, int> &constants, std::string &name) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto functionIndex = specializations.find(functionName);
+        if(functionIndex==specializations.end()){
+            return false;
+        }
+        bool found = false;
+        for (auto &specialization : functionIndex->second){
+            if (found && specialization.constants.size()<=constants.size()){
+                continue;
+            }
+            bool fits = true;
+            for (auto &constant : specialization.constants){
+                auto argument = arguments.find(constant.first);
+                fits = fits && argument!=arguments.end() && argument->second==constant.second;
+            }
+            if (fits){
+                constants=specialization.constants;
+                name=specialization.name;
+                found=true;
+            }
+        }
+        return found;
+    }
+
+    void declareFunction(std::string functionName){
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        declaredFunctions.push_back(functionName);
+    }
+    bool isFunctionDeclared(std::string functionName) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return std::find(declaredFunctions.begin(), declaredFunctions.end(), functionName)!=declaredFunctions.end();
+    }
+};
 
 // An object of class Context is passed between AST nodes during compilation.
 // This can be used to pass around information about what's currently being
@@ -11,13 +144,42 @@ class Context
 {
 private:
     std::map<std::string, int> variableStackAddresses; // Variable name binding to stack location
-    std::map<std::string, std::string> variableTypes; // Variable name binding to type
+    std::map<std::string, std::string> variableTypes; // Variable name binding to type (element type for arrays)
+    std::map<std::string, int> arrayLengths; // Array name binding to number of elements
 
-    std::vector<std::string> declaredFunctions; // Functions that have been declared (and can be called)
+    std::shared_ptr<SymbolTable> symbols = std::make_shared<SymbolTable>(); // Shared with the contexts of the file's functions
+    std::map<std::string, std::set<std::string>> functionClobbers; // Caller-saved registers each compiled function may overwrite
+
+    // State of the function being compiled
+    std::string functionName; // Name emitted for it, which differs from the declared one for copies
+    std::string returnLabel; // Label of the epilogue that return statements jump to
+    std::set<int> usedSavedRegisters; // Callee-saved registers the prologue has to save
+    int integerParameters = 0; // Integer and floating point arguments are passed in a0-a7 and fa0-fa7
+    int floatParameters = 0;
+    std::map<std::string, int> promotedVariables; // Variables kept in a register instead of their stack slot
+    std::map<std::string, int> parameterValues; // Parameters fixed by the specialization being compiled
+
+    std::map<const Node*, int> hoistedExpressions; // Loop-invariant expressions evaluated once in a loop preheader
+    std::map<std::string, int> knownValues; // Variables whose value is known while compiling, e.g. in an unrolled loop
+    std::map<const Node*, int> decidedConditions; // Branch conditions already tested before an unswitched loop
+
+    // A register walking through an array alongside a loop induction variable.
+    // It holds the address of array[variable - lag]: inside an unrolled trip the
+    // variable moves on while the register is only updated once per trip.
+    struct ArrayPointer
+    {
+        std::string variable;
+        int reg;
+        int lag;
+    };
+    std::map<std::string, ArrayPointer> arrayPointers; // Array name binding to its pointer induction variable
 
-    bool functionCalled=false;
+    std::map<std::string, long long> statistics; // Counters reported by -stats, e.g. folded constants
+    int branchLabels = 0; // Number of local labels made so far
 
-    std::vector<int> paramRegisters;
+    int unrollFactor = 4; // Number of copies of the body in a partially unrolled loop
+    bool functionSections = true; // Put each function in its own section, so the linker can drop unused ones
+    int codegenThreads = 1; // Threads compiling the functions of the file
 
     int usedRegisters[32] = {
         1, //x0 i = 0, reg zero
@@ -26,14 +188,39 @@ private:
         1,  //x3 i = 3, global pointer gp
         1, //x4 i = 4, thread pointer tp
         0, 0, 0,  //t0-t2 i= 5-7, temporary registers
-        1, 1,  //s0-s1 i = 8-9, saved registers
+        1, 0,  //s0-s1 i = 8-9, frame pointer and saved register
         0, //a0 i=10, return result
         0, 0, 0, 0, 0, 0, 0, //a1-a7 i = 11-17, argument registers
-        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //s2-s11 i = 18-27, saved registers
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, //s2-s11 i = 18-27, saved registers
         0, 0, 0, 0, //t3-t6 i = 28-31, temporary registers
     };
 
+    int lastTemporary = 5; // Index of the temporary allocated most recently
+
     int currentStackLocation = -16;
+    int lowestStackLocation = -16; // Deepest slot in use at any point of the function
+
+    // Bindings visible outside a block, restored when it ends. The stack
+    // slots of the block's own variables are free again after it, so a later
+    // block reuses them.
+    struct Scope
+    {
+        std::map<std::string, int> variableStackAddresses;
+        std::map<std::string, std::string> variableTypes;
+        std::map<std::string, int> arrayLengths;
+        std::map<std::string, int> promotedVariables;
+        std::map<std::string, int> knownValues;
+        int stackLocation;
+    };
+    std::vector<Scope> scopes;
+
+    // Reserve a slot below the ones in use, aligned to its own size
+    int allocateStackSlot(int size, int alignment){
+        currentStackLocation=currentStackLocation-size;
+        currentStackLocation=-((-currentStackLocation+alignment-1)/alignment*alignment);
+        lowestStackLocation=std::min(lowestStackLocation, currentStackLocation);
+        return currentStackLocation;
+    }
 
 public:
 
@@ -47,53 +234,189 @@ public:
         }
     }
 
-    // track function calls
-    void callFunction(){
-        functionCalled=true;
+    // Start compiling a new function. Locals are addressed from the frame
+    // pointer s0; the return address and old frame pointer sit just below it.
+    void beginFunction(std::string functionName, std::string returnType){
+        symbols->setFunctionType(functionName, returnType);
+        this->functionName=functionName;
+        variableStackAddresses.clear();
+        variableTypes.clear();
+        arrayLengths.clear();
+        usedSavedRegisters.clear();
+        integerParameters=0;
+        floatParameters=0;
+        promotedVariables.clear();
+        parameterValues.clear();
+        knownValues.clear();
+        scopes.clear();
+        currentStackLocation=-16;
+        lowestStackLocation=-16;
+        returnLabel=nameNewBranch();
+    }
+    std::string getReturnLabel(){
+        return returnLabel;
+    }
+    std::set<int> getUsedSavedRegisters(){
+        return usedSavedRegisters;
+    }
+    // Frame size once the body has been compiled: locals below the frame
+    // pointer, saved registers at the bottom, 16-byte aligned
+    int getFrameSize(){
+        int frameSize = -lowestStackLocation + 4*usedSavedRegisters.size();
+        return (frameSize+15)/16*16;
     }
 
-    bool isFunctionCalled(){
-        return functionCalled;
+    void setFunctionType(std::string functionName, std::string returnType){
+        symbols->setFunctionType(functionName, returnType);
+    }
+    std::string getFunctionType(std::string functionName){
+        return symbols->getFunctionType(functionName);
     }
 
-    void uncallFunction(){
-        functionCalled=false;
+    // Record the caller-saved registers a compiled function overwrites, so
+    // that its callers only need to keep the others safe across a call.
+    // Returns false for a function not compiled yet, which may clobber any.
+    void setFunctionClobbers(std::string functionName, std::set<std::string> registers){
+        functionClobbers[functionName]=registers;
+    }
+    bool getFunctionClobbers(std::string functionName, std::set<std::string> &registers){
+        auto functionIndex = functionClobbers.find(functionName);
+        if(functionIndex!=functionClobbers.end()){
+            registers=functionIndex->second;
+            return true;
+        }
+        return false;
+    }
+
+    // Track functions with internal linkage
+    void setInternalFunction(std::string functionName){
+        symbols->setInternalFunction(functionName);
+    }
+    bool isInternalFunction(std::string functionName){
+        return symbols->isInternalFunction(functionName);
     }
 
-    void addParamRegister(int paramRegister){
-        paramRegisters.push_back(paramRegister);
+    // Track which functions are const or pure, from attributes on their
+    // declarations or from their bodies. Any other function may have side effects.
+    void setFunctionEffect(std::string functionName, FunctionEffect effect){
+        symbols->setFunctionEffect(functionName, effect);
+    }
+    FunctionEffect getFunctionEffect(std::string functionName){
+        return symbols->getFunctionEffect(functionName);
     }
 
-    std::vector<int> getParamRegisters(){
-        return paramRegisters;
+    // Track how often each function ran in the profile being used. A
+    // function is cold if neither it nor any copy of it ever ran; functions
+    // the profile does not know about are not.
+    void setFunctionCount(std::string functionName, long long count){
+        symbols->setFunctionCount(functionName, count);
+    }
+    bool isColdFunction(std::string functionName){
+        return symbols->isColdFunction(functionName);
     }
 
+    // Track specialized copies of functions. A call uses the copy that takes
+    // the most of the constant arguments it passes; returns false if none fits.
+    std::string addSpecialization(std::string functionName, std::map<int, int> constants){
+        return symbols->addSpecialization(functionName, constants);
+    }
+    bool findSpecialization(std::string functionName, const std::map<int, int> &arguments, std::map<int, int> &constants, std::string &name){
+        return symbols->findSpecialization(functionName, arguments, constants, name);
+    }
+    void setParameterValue(std::string parameterName, int value){
+        parameterValues[parameterName]=value;
+    }
+    bool parameterValue(std::string parameterName, int &value){
+        auto parameterIndex = parameterValues.find(parameterName);
+        if(parameterIndex!=parameterValues.end()){
+            value=parameterIndex->second;
+            return true;
+        }
+        return false;
+    }
+
+    // Register the next parameter of the given type arrives in
+    int nextParameterRegister(std::string type){
+        if (type=="float" || type=="double"){
+            return 10+floatParameters++;
+        }
+        return 10+integerParameters++;
+    }
+
+    // Labels are numbered per file, so compiling one file does not depend
+    // on what else the process compiled. A function context numbers its
+    // own from 1, and the translation unit shifts them past the labels of
+    // the functions before it.
     std::string nameNewBranch(){
-       static int x=0;
-       x++;
-       return "L" + std::to_string(x);
+       branchLabels++;
+       return "L" + std::to_string(branchLabels);
     }
     // Declare a new function
     void declareFunction(std::string functionName){
-        declaredFunctions.push_back(functionName);
+        symbols->declareFunction(functionName);
     }
 
     bool isFunctionDeclared(std::string functionName){
-        auto functionIndex = std::find(declaredFunctions.begin(), declaredFunctions.end(), functionName);
-        if(functionIndex==declaredFunctions.end()){
-            return false;
-        }
-        else{
-            return true;
-        }
+        return symbols->isFunctionDeclared(functionName);
     }
 
-    // Add and find variables
+    // Blocks: variables declared in a block go out of scope at its end
+    void enterScope(){
+        scopes.push_back({variableStackAddresses, variableTypes, arrayLengths, promotedVariables, knownValues, currentStackLocation});
+    }
+    void exitScope(){
+        Scope &scope = scopes.back();
+        variableStackAddresses=scope.variableStackAddresses;
+        variableTypes=scope.variableTypes;
+        arrayLengths=scope.arrayLengths;
+        promotedVariables=scope.promotedVariables;
+        knownValues=scope.knownValues;
+        currentStackLocation=scope.stackLocation;
+        scopes.pop_back();
+    }
+
+    // Add and find variables. A new declaration hides any register or known
+    // value the name had outside the block.
     int bindVariable(std::string variableName, std::string variableType){
-        currentStackLocation=currentStackLocation-4;
-        variableStackAddresses[variableName]=currentStackLocation;
+        int size = getTypeSize(variableType);
+        int location = allocateStackSlot(size, size);
+        variableStackAddresses[variableName]=location;
         variableTypes[variableName]=variableType;
-        return currentStackLocation;
+        arrayLengths.erase(variableName);
+        promotedVariables.erase(variableName);
+        knownValues.erase(variableName);
+        return location;
+    }
+    // Arrays take one slot per element, with element 0 at the lowest address
+    int bindArray(std::string arrayName, std::string elementType, int length){
+        int elementSize = getTypeSize(elementType);
+        int location = allocateStackSlot(length*elementSize, std::max(elementSize, 4));
+        variableStackAddresses[arrayName]=location;
+        variableTypes[arrayName]=elementType;
+        arrayLengths[arrayName]=length;
+        promotedVariables.erase(arrayName);
+        knownValues.erase(arrayName);
+        return location;
+    }
+    // Anonymous slot, e.g. to keep a register across a call. Allocated inside
+    // a scope, it is free again once that scope ends.
+    int allocateSpillSlot(int size){
+        return allocateStackSlot(size, size);
+    }
+    bool isArray(std::string variableName){
+        return arrayLengths.find(variableName)!=arrayLengths.end();
+    }
+    int getTypeSize(std::string type){
+        if (type=="double"){
+            return 8;
+        }
+        else if (type=="char"){
+            return 1;
+        }
+        else if (type=="short"){
+            return 2;
+        }
+        return 4;
     }
     int variableLocation(std::string variableName){
         auto variableIndex = variableStackAddresses.find(variableName);
@@ -105,6 +428,140 @@ public:
         }
     }
 
+    // Track expressions hoisted out of the loop being compiled
+    void hoistExpression(const Node* expression, int reg){
+        hoistedExpressions[expression]=reg;
+    }
+    void unhoistExpression(const Node* expression){
+        hoistedExpressions.erase(expression);
+    }
+    int hoistedRegister(const Node* expression){
+        auto expressionIndex = hoistedExpressions.find(expression);
+        if(expressionIndex!=hoistedExpressions.end()){
+            return expressionIndex->second;
+        }
+        else{
+            return -1;
+        }
+    }
+
+    // Track variables with a value known at compile time
+    void setKnownValue(std::string variableName, int value){
+        knownValues[variableName]=value;
+    }
+    void forgetKnownValue(std::string variableName){
+        knownValues.erase(variableName);
+    }
+    bool knownValue(std::string variableName, int &value){
+        auto variableIndex = knownValues.find(variableName);
+        if(variableIndex!=knownValues.end()){
+            value=variableIndex->second;
+            return true;
+        }
+        return false;
+    }
+
+    // Track branch conditions decided by loop unswitching
+    void decideCondition(const Node* condition, int value){
+        decidedConditions[condition]=value;
+    }
+    void undecideCondition(const Node* condition){
+        decidedConditions.erase(condition);
+    }
+    bool decidedCondition(const Node* condition, int &value){
+        auto conditionIndex = decidedConditions.find(condition);
+        if(conditionIndex!=decidedConditions.end()){
+            value=conditionIndex->second;
+            return true;
+        }
+        return false;
+    }
+
+    // Track pointers strength-reduced from array indexing in loops
+    void bindArrayPointer(std::string arrayName, std::string variable, int reg){
+        arrayPointers[arrayName]={variable, reg, 0};
+    }
+    void unbindArrayPointer(std::string arrayName){
+        arrayPointers.erase(arrayName);
+    }
+    bool arrayPointer(std::string arrayName, std::string &variable, int &reg, int &lag){
+        auto arrayIndex = arrayPointers.find(arrayName);
+        if(arrayIndex!=arrayPointers.end()){
+            variable=arrayIndex->second.variable;
+            reg=arrayIndex->second.reg;
+            lag=arrayIndex->second.lag;
+            return true;
+        }
+        return false;
+    }
+    void setArrayPointerLag(std::string arrayName, int lag){
+        arrayPointers[arrayName].lag=lag;
+    }
+
+    // Track variables kept in registers
+    void promoteVariable(std::string variableName, int reg){
+        promotedVariables[variableName]=reg;
+    }
+    void demoteVariable(std::string variableName){
+        promotedVariables.erase(variableName);
+    }
+    int promotedRegister(std::string variableName){
+        auto variableIndex = promotedVariables.find(variableName);
+        if(variableIndex!=promotedVariables.end()){
+            return variableIndex->second;
+        }
+        return -1;
+    }
+
+    void setUnrollFactor(int factor){
+        unrollFactor=factor;
+    }
+    // Loops in cold functions are left rolled up, to keep them small
+    int getUnrollFactor(){
+        return isColdFunction(functionName) ? 1 : unrollFactor;
+    }
+    void setFunctionSections(bool enabled){
+        functionSections=enabled;
+    }
+    bool getFunctionSections(){
+        return functionSections;
+    }
+    void setCodegenThreads(int threads){
+        codegenThreads=threads;
+    }
+    int getCodegenThreads(){
+        return codegenThreads;
+    }
+
+    // A context to compile one function of the file in, possibly on a
+    // thread of its own. It shares the symbol table, but knows the clobbers
+    // of no compiled function and starts with no labels or statistics, so
+    // that mergeFunction can add them to the file's.
+    Context functionContext() const {
+        Context function(*this);
+        function.functionClobbers.clear();
+        function.statistics.clear();
+        function.branchLabels=0;
+        return function;
+    }
+    void mergeFunction(const Context &function){
+        for (auto &counter : function.statistics){
+            statistics[counter.first]+=counter.second;
+        }
+        branchLabels+=function.branchLabels;
+    }
+    int getBranchLabels(){
+        return branchLabels;
+    }
+
+    // Count what the compiler did, for -stats
+    void countStatistic(std::string counter, long long count = 1){
+        statistics[counter]+=count;
+    }
+    std::map<std::string, long long> getStatistics(){
+        return statistics;
+    }
+
     // Use or free registers
     void useRegister(int i){
         usedRegisters[i]=1;
@@ -113,37 +570,70 @@ public:
         usedRegisters[i]=0;
     }
 
-    // Allocate registers
+    // Allocate registers. Temporaries are for values that do not live across
+    // a call; the caller saves any that are still in use when it makes one.
+    // They are handed out round-robin, so that the scheduler is not held back
+    // by unrelated values reusing the register that was just freed.
     int findFreeRegister(){
-        for (int i=5;i<9;i++){ // Allocate to temp and saved registers
+        static const int temporaries[] = {5, 6, 7, 28, 29, 30};
+        for (int k=1;k<=6;k++){
+            int i = temporaries[(lastTemporary+k)%6];
             if (usedRegisters[i]==0){
                 useRegister(i);
+                lastTemporary = (lastTemporary+k)%6;
                 return i;
             }
         }
-        for (int i=18;i<31;i++){ // Allocate to temp and saved registers
+        return -1; // No free register found
+    }
+    int countFreeRegisters(){
+        int freeRegisters=0;
+        for (int i=5;i<8;i++){
             if (usedRegisters[i]==0){
-                useRegister(i);
-                return i;
+                freeRegisters++;
             }
         }
-        return -1; // No free register found
+        for (int i=28;i<31;i++){
+            if (usedRegisters[i]==0){
+                freeRegisters++;
+            }
+        }
+        return freeRegisters;
     }
-    int findFreeParamRegister(){
-        for (int i=10;i<17;i++){ // Allocate to parameter registers
+    // Saved registers hold values that live across calls. Each one used is
+    // saved by the prologue and restored by the epilogue.
+    int findFreeSavedRegister(){
+        for (int i : {9, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27}){
             if (usedRegisters[i]==0){
                 useRegister(i);
+                usedSavedRegisters.insert(i);
                 return i;
             }
         }
         return -1;
     }
+    // Temporaries that hold a value at this point
+    std::vector<int> getUsedTemporaries(){
+        std::vector<int> temporaries;
+        for (int i : {5, 6, 7, 28, 29, 30}){
+            if (usedRegisters[i]==1){
+                temporaries.push_back(i);
+            }
+        }
+        return temporaries;
+    }
 
     // Get Register Name for RISC-V
     std::string getRegisterName(int i){
         if((i>4)&&(i<8)){
             return 't'+std::to_string(i-5);
         }
+        else if((i>7)&&(i<10)){
+            return 's'+std::to_string(i-8);
+        }
+        else if((i>17)&&(i<28)){
+            return 's'+std::to_string(i-16);
+        }
         else if((i>9)&&(i<18)){
             return 'a'+std::to_string(i-10);
         }
@@ -1,9 +1,147 @@
 #ifndef CONTROL_FLOW_HPP
 #define CONTROL_FLOW_HPP
 
+#include <climits>
+
 #include "node.hpp"
 
-class WhileLoop : public Node
+// Common base for loops. Loops are emitted as natural loops: a preheader,
+// a header label that the single back edge jumps to, and an exit label.
+// Expressions that do not change while the loop runs are evaluated once in
+// the preheader and kept in registers for the whole loop.
+class Loop : public Node
+{
+protected:
+    // Keep enough temporaries free for the loop body itself
+    static const int minFreeRegisters = 4;
+
+private:
+    // Size limit, in AST nodes, of all the copies made by unswitching
+    static const int maxUnswitchedNodes = 400;
+
+    // Branch conditions inside the loop that do not change while it runs
+    void FindInvariantConditions(const Node *node, const std::set<std::string> &loopWrites, bool loopWritesMemory, Context &context, std::vector<Node*> &conditions) const {
+        Node *condition = node->GetBranchCondition();
+        int value;
+        if (condition!=nullptr && condition->IsLoopInvariant(context, loopWrites, loopWritesMemory) && !condition->GetConstantValue(context, value)
+            && !context.decidedCondition(condition, value)){
+            conditions.push_back(condition);
+        }
+        for (auto child : node->GetChildren()){
+            if (child != nullptr){
+                FindInvariantConditions(child, loopWrites, loopWritesMemory, context, conditions);
+            }
+        }
+    }
+
+protected:
+    // The parts of the loop that run on every iteration
+    virtual std::vector<Node*> GetLoopParts() const = 0;
+    // Emit the loop itself, starting with its preheader
+    virtual void EmitLoopVersion(std::ostream &stream, Context &context, int destReg) const = 0;
+
+    // Loop unswitching: a branch condition that does not change inside the
+    // loop is tested once before it, and a copy of the loop with the branch
+    // already decided is emitted for each outcome.
+    void EmitUnswitched(std::ostream &stream, Context &context, int destReg, int copies) const {
+        std::set<std::string> loopWrites;
+        std::vector<Node*> conditions;
+        int loopSize = 0;
+        bool loopWritesMemory = false;
+        for (auto part : GetLoopParts()){
+            if (part != nullptr){
+                part->GetWrittenVariables(loopWrites);
+                loopSize += part->CountNodes();
+                loopWritesMemory = loopWritesMemory || part->CallsFunctionWithSideEffects(context);
+            }
+        }
+        for (auto part : GetLoopParts()){
+            if (part != nullptr){
+                FindInvariantConditions(part, loopWrites, loopWritesMemory, context, conditions);
+            }
+        }
+        if (conditions.empty() || loopSize*copies*2 > maxUnswitchedNodes){
+            EmitLoopVersion(stream, context, destReg);
+            return;
+        }
+
+        Node *condition = conditions.front();
+        std::string falseBranch = context.nameNewBranch();
+        std::string continueBranch = context.nameNewBranch();
+        int conditionValueRegister = context.findFreeRegister();
+        condition->EmitRISC(stream, context, conditionValueRegister);
+        stream << "beq " << context.getRegisterName(conditionValueRegister) << ", zero, " << falseBranch << std::endl;
+        context.freeRegister(conditionValueRegister);
+
+        context.decideCondition(condition, 1);
+        EmitUnswitched(stream, context, destReg, copies*2);
+        stream << "j " << continueBranch << std::endl;
+        stream << falseBranch << ":" << std::endl;
+        context.decideCondition(condition, 0);
+        EmitUnswitched(stream, context, destReg, copies*2);
+        stream << continueBranch << ":" << std::endl;
+        context.undecideCondition(condition);
+    }
+
+    std::vector<const Node*> HoistInvariants(std::ostream &stream, Context &context, std::vector<Node*> loopParts) const {
+        std::vector<const Node*> hoisted;
+        std::set<std::string> loopWrites;
+        bool hasCall = false;
+        bool loopWritesMemory = false;
+        for (auto part : loopParts){
+            if (part != nullptr){
+                part->GetWrittenVariables(loopWrites);
+                hasCall = hasCall || part->HasFunctionCall();
+                loopWritesMemory = loopWritesMemory || part->CallsFunctionWithSideEffects(context);
+            }
+        }
+
+        // Calls to const and pure functions are hoisted like any other
+        // expression
+        std::vector<const Node*> invariants;
+        for (auto part : loopParts){
+            if (part != nullptr){
+                part->FindLoopInvariants(context, loopWrites, loopWritesMemory, invariants);
+            }
+        }
+        for (auto invariant : invariants){
+            // Already hoisted by an enclosing loop, or folds to a constant anyway
+            int value;
+            if (context.hoistedRegister(invariant) != -1 || invariant->GetConstantValue(context, value)
+                || context.decidedCondition(invariant, value)){
+                continue;
+            }
+            // Temporaries are clobbered by calls, so across one the value has
+            // to be kept in a saved register instead
+            int invariantRegister;
+            if (hasCall){
+                invariantRegister = context.findFreeSavedRegister();
+                if (invariantRegister == -1){
+                    break;
+                }
+            }
+            else{
+                if (context.countFreeRegisters() <= minFreeRegisters){
+                    break;
+                }
+                invariantRegister = context.findFreeRegister();
+            }
+            invariant->EmitRISC(stream, context, invariantRegister);
+            context.hoistExpression(invariant, invariantRegister);
+            hoisted.push_back(invariant);
+        }
+        return hoisted;
+    }
+
+    void ReleaseInvariants(Context &context, const std::vector<const Node*> &hoisted) const {
+        for (auto invariant : hoisted){
+            context.freeRegister(context.hoistedRegister(invariant));
+            context.unhoistExpression(invariant);
+        }
+    }
+};
+
+class WhileLoop : public Loop
 {
 private:
     Node* condition;
@@ -14,20 +152,34 @@ public:
         delete condition;
         delete statement;
     }
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+    std::vector<Node*> GetLoopParts() const {
+        return {condition, statement};
+    }
+
+    void EmitLoopVersion(std::ostream &stream, Context &context, int destReg) const {
+        std::vector<const Node*> hoisted = HoistInvariants(stream, context, GetLoopParts());
         std::string loopStartLabel = context.nameNewBranch();
         std::string loopEndLabel = context.nameNewBranch();
         stream << loopStartLabel << ":" << std::endl;
         int conditionValueRegister = context.findFreeRegister();
+        condition->EmitRISC(stream, context, conditionValueRegister);
         stream << "beq " << context.getRegisterName(conditionValueRegister) << ", zero, " << loopEndLabel << std::endl;
+        context.freeRegister(conditionValueRegister);
         if(statement!=nullptr){
             statement->EmitRISC(stream, context, destReg);
-            stream << "j " << loopStartLabel << std::endl;
         }
+        stream << "j " << loopStartLabel << std::endl;
         stream << loopEndLabel << ":" << std::endl;
-        context.freeRegister(conditionValueRegister);
+        ReleaseInvariants(context, hoisted);
+    }
+
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        EmitUnswitched(stream, context, destReg, 1);
     }
 
+    std::vector<Node *> GetChildren() const {
+        return {condition, statement};
+    }
 
     void Print(std::ostream &stream) const {
         stream<<"while(";
@@ -40,13 +192,317 @@ public:
     }
 };
 
-class ForLoop : public Node
+class ForLoop : public Loop
 {
 private:
     Node* initialization;
     Node* condition;
     Node* iteration;
     Node* statement;
+
+    // Loops with at most this many iterations are unrolled completely
+    static const int maxFullUnrollTrips = 8;
+    // Size limit, in AST nodes, of the unrolled loop body
+    static const int maxUnrolledNodes = 200;
+
+    // Arrays indexed by `i + c` in a counted loop are walked with a pointer
+    // per array that advances by the element size, instead of scaling i on
+    // every access. When i has no other use in the body, it is not kept up to
+    // date inside the loop at all: the exit test compares the first pointer
+    // against a pointer to array[bound], and i is recovered from the pointer
+    // when the loop exits.
+    struct PointerInductions
+    {
+        std::vector<std::string> arrays;
+        int endRegister = -1;
+        int step = 0;
+        std::string comparison;
+    };
+
+    // Local arrays indexed by `variable + c`, other than those already walked
+    // by an enclosing loop. Sets otherUses if the variable is read in any
+    // other way.
+    void FindInductionArrays(const Node *node, Context &context, const std::string &variable, std::vector<std::string> &arrays, bool &otherUses) const {
+        std::string array, pointerVariable;
+        Node *index;
+        int offset, pointerRegister, lag;
+        if (node->GetArrayAccess(array, index) && context.isArray(array) && index->GetOffset(context, variable, offset)
+            && !context.arrayPointer(array, pointerVariable, pointerRegister, lag)){
+            if (std::find(arrays.begin(), arrays.end(), array) == arrays.end()){
+                arrays.push_back(array);
+            }
+            return;
+        }
+        if (node->IsVariable() && node->GetIdentifier()==variable){
+            otherUses = true;
+        }
+        for (auto child : node->GetChildren()){
+            if (child != nullptr){
+                FindInductionArrays(child, context, variable, arrays, otherUses);
+            }
+        }
+    }
+
+    int GetElementShift(Context &context, std::string array) const {
+        int elementSize = context.getTypeSize(context.getVariableType(array));
+        int shift = 0;
+        while ((1 << shift) < elementSize){
+            shift++;
+        }
+        return shift;
+    }
+
+    // reg = s0 + location(array) + (reg << shift)
+    void EmitElementAddress(std::ostream &stream, Context &context, std::string array, int reg) const {
+        std::string address = context.getRegisterName(reg);
+        int shift = GetElementShift(context, array);
+        if (shift > 0){
+            stream << "slli " << address << ", " << address << ", " << shift << std::endl;
+        }
+        stream << "add " << address << ", " << address << ", s0" << std::endl;
+        stream << "addi " << address << ", " << address << ", " << context.variableLocation(array) << std::endl;
+    }
+
+    // Set up the pointers in the preheader. Returns false, emitting nothing,
+    // if there is nothing to reduce or not enough registers to do it.
+    bool EmitPointerInductions(std::ostream &stream, Context &context, std::string variable, int step, std::string comparison, Node *bound, PointerInductions &pointers) const {
+        bool otherUses = false;
+        FindInductionArrays(statement, context, variable, pointers.arrays, otherUses);
+        int registersNeeded = pointers.arrays.size() + (otherUses ? 0 : 1);
+        if (pointers.arrays.empty() || statement->HasFunctionCall() || context.countFreeRegisters() - registersNeeded < minFreeRegisters){
+            pointers.arrays.clear();
+            return false;
+        }
+
+        for (auto array : pointers.arrays){
+            int pointerRegister = context.findFreeRegister();
+            EmitVariableLoad(stream, context, variable, pointerRegister);
+            EmitElementAddress(stream, context, array, pointerRegister);
+            context.bindArrayPointer(array, variable, pointerRegister);
+        }
+        if (!otherUses){
+            pointers.endRegister = context.findFreeRegister();
+            bound->EmitRISC(stream, context, pointers.endRegister);
+            EmitElementAddress(stream, context, pointers.arrays.front(), pointers.endRegister);
+        }
+        pointers.step = step;
+        pointers.comparison = comparison;
+        return true;
+    }
+
+    // On loop exit, store i if it was not kept up to date and release the pointers
+    void ReleasePointerInductions(std::ostream &stream, Context &context, std::string variable, PointerInductions &pointers) const {
+        if (pointers.endRegister != -1){
+            std::string array = pointers.arrays.front();
+            std::string pointerVariable;
+            int pointerRegister, lag;
+            context.arrayPointer(array, pointerVariable, pointerRegister, lag);
+            int indexRegister = context.findFreeRegister();
+            std::string index = context.getRegisterName(indexRegister);
+            stream << "sub " << index << ", " << context.getRegisterName(pointerRegister) << ", s0" << std::endl;
+            stream << "addi " << index << ", " << index << ", " << -context.variableLocation(array) << std::endl;
+            stream << "srai " << index << ", " << index << ", " << GetElementShift(context, array) << std::endl;
+            EmitVariableStore(stream, context, variable, indexRegister);
+            context.freeRegister(indexRegister);
+            context.freeRegister(pointers.endRegister);
+            pointers.endRegister = -1;
+        }
+        for (auto array : pointers.arrays){
+            std::string pointerVariable;
+            int pointerRegister, lag;
+            context.arrayPointer(array, pointerVariable, pointerRegister, lag);
+            context.freeRegister(pointerRegister);
+            context.unbindArrayPointer(array);
+        }
+        pointers.arrays.clear();
+    }
+
+    // One iteration has been emitted: the pointers now lag one more step
+    // behind i. Emit the iteration statement itself unless i is dead.
+    void EmitIteration(std::ostream &stream, Context &context, int destReg, const PointerInductions &pointers) const {
+        if (pointers.endRegister == -1 && iteration){
+            iteration->EmitRISC(stream, context, destReg);
+        }
+        for (auto array : pointers.arrays){
+            std::string pointerVariable;
+            int pointerRegister, lag;
+            context.arrayPointer(array, pointerVariable, pointerRegister, lag);
+            context.setArrayPointerLag(array, lag + pointers.step);
+        }
+    }
+
+    // Catch the pointers up with i at the end of a trip
+    void EmitPointerUpdates(std::ostream &stream, Context &context, const PointerInductions &pointers) const {
+        for (auto array : pointers.arrays){
+            std::string pointerVariable;
+            int pointerRegister, lag;
+            context.arrayPointer(array, pointerVariable, pointerRegister, lag);
+            std::string pointer = context.getRegisterName(pointerRegister);
+            int elementSize = context.getTypeSize(context.getVariableType(array));
+            stream << "addi " << pointer << ", " << pointer << ", " << lag*elementSize << std::endl;
+            context.setArrayPointerLag(array, 0);
+        }
+    }
+
+    // Branch to exitLabel unless `index CMP limit` holds
+    void EmitExitBranch(std::ostream &stream, std::string comparison, std::string index, std::string limit, std::string exitLabel, bool isUnsigned) const {
+        std::string suffix = isUnsigned ? "u" : "";
+        if (comparison=="<"){
+            stream << "bge" << suffix << " " << index << ", " << limit << ", " << exitLabel << std::endl;
+        }
+        else if (comparison=="<="){
+            stream << "blt" << suffix << " " << limit << ", " << index << ", " << exitLabel << std::endl;
+        }
+        else if (comparison==">"){
+            stream << "bge" << suffix << " " << limit << ", " << index << ", " << exitLabel << std::endl;
+        }
+        else{
+            stream << "blt" << suffix << " " << index << ", " << limit << ", " << exitLabel << std::endl;
+        }
+    }
+
+    // Exit test against the end pointer, `lookahead` iterations ahead
+    void EmitPointerExitTest(std::ostream &stream, Context &context, const PointerInductions &pointers, int lookahead, std::string exitLabel) const {
+        std::string array = pointers.arrays.front();
+        std::string pointerVariable;
+        int pointerRegister, lag;
+        context.arrayPointer(array, pointerVariable, pointerRegister, lag);
+        int elementSize = context.getTypeSize(context.getVariableType(array));
+        std::string pointer = context.getRegisterName(pointerRegister);
+        int testRegister = -1;
+        if (lookahead != 0){
+            testRegister = context.findFreeRegister();
+            stream << "addi " << context.getRegisterName(testRegister) << ", " << pointer << ", " << lookahead*pointers.step*elementSize << std::endl;
+            pointer = context.getRegisterName(testRegister);
+        }
+        EmitExitBranch(stream, pointers.comparison, pointer, context.getRegisterName(pointers.endRegister), exitLabel, true);
+        if (testRegister != -1){
+            context.freeRegister(testRegister);
+        }
+    }
+
+    // Recognise `for (...; i CMP bound; i += step)` where only the iteration
+    // statement changes i and the bound does not change inside the loop
+    bool GetCountedLoop(Context &context, std::string &variable, int &step, std::string &comparison, Node *&bound) const {
+        if (!condition || !iteration || !statement){
+            return false;
+        }
+        std::string boundVariable;
+        if (!iteration->GetIncrement(context, variable, step) || step==0){
+            return false;
+        }
+        if (!condition->GetLoopBound(boundVariable, comparison, bound) || boundVariable!=variable){
+            return false;
+        }
+        if (context.getVariableType(variable)!="int"){
+            return false;
+        }
+        if ((comparison=="<" || comparison=="<=") ? step<0 : (comparison==">" || comparison==">=") ? step>0 : true){
+            return false;
+        }
+        std::set<std::string> loopWrites;
+        std::set<std::string> iterationWrites;
+        statement->GetWrittenVariables(loopWrites);
+        iteration->GetWrittenVariables(iterationWrites);
+        if (loopWrites.count(variable) || iterationWrites.size()!=1){
+            return false;
+        }
+        loopWrites.insert(variable);
+        return bound->IsLoopInvariant(context, loopWrites, statement->CallsFunctionWithSideEffects(context));
+    }
+
+    // Number of iterations of a counted loop with known start and bound
+    bool GetTripCount(int start, int step, std::string comparison, int bound, int &trips) const {
+        long long distance;
+        if (comparison=="<"){
+            distance = (long long)bound - start;
+        }
+        else if (comparison=="<="){
+            distance = (long long)bound - start + 1;
+        }
+        else if (comparison==">"){
+            distance = (long long)start - bound;
+        }
+        else{
+            distance = (long long)start - bound + 1;
+        }
+        long long absoluteStep = step > 0 ? step : -(long long)step;
+        long long count = distance <= 0 ? 0 : (distance + absoluteStep - 1) / absoluteStep;
+        long long last = (long long)start + count * step;
+        if (last < INT_MIN || last > INT_MAX){
+            return false;
+        }
+        trips = (int)count;
+        return true;
+    }
+
+    // Emit the body once per iteration with the induction variable known, so
+    // that expressions using it fold to constants
+    void EmitUnrolledIterations(std::ostream &stream, Context &context, int destReg, std::string variable, int first, int step, int trips) const {
+        for (int i=0; i<trips; i++){
+            context.setKnownValue(variable, first + i*step);
+            statement->EmitRISC(stream, context, destReg);
+        }
+        // Leave the induction variable with the value it has after the loop
+        if (trips > 0){
+            context.setKnownValue(variable, first + (trips-1)*step);
+            iteration->EmitRISC(stream, context, destReg);
+        }
+        context.forgetKnownValue(variable);
+    }
+
+    // Run `factor` copies of the body per trip while at least that many
+    // iterations remain. The check `i + (factor-1)*step CMP bound` assumes the
+    // induction variable does not overflow, as a counted loop in C cannot.
+    void EmitUnrolledLoop(std::ostream &stream, Context &context, int destReg, std::string variable, int step, std::string comparison, Node *bound, int factor, const PointerInductions &pointers) const {
+        std::string loopStartLabel = context.nameNewBranch();
+        std::string remainderLabel = context.nameNewBranch();
+        stream << loopStartLabel << ":" << std::endl;
+
+        if (pointers.endRegister != -1){
+            EmitPointerExitTest(stream, context, pointers, factor-1, remainderLabel);
+        }
+        else{
+            int indexRegister = context.findFreeRegister();
+            int boundRegister = context.findFreeRegister();
+            EmitVariableLoad(stream, context, variable, indexRegister);
+            stream << "addi " << context.getRegisterName(indexRegister) << ", " << context.getRegisterName(indexRegister) << ", " << (factor-1)*step << std::endl;
+            bound->EmitRISC(stream, context, boundRegister);
+            EmitExitBranch(stream, comparison, context.getRegisterName(indexRegister), context.getRegisterName(boundRegister), remainderLabel, false);
+            context.freeRegister(indexRegister);
+            context.freeRegister(boundRegister);
+        }
+
+        for (int i=0; i<factor; i++){
+            statement->EmitRISC(stream, context, destReg);
+            EmitIteration(stream, context, destReg, pointers);
+        }
+        EmitPointerUpdates(stream, context, pointers);
+        stream << "j " << loopStartLabel << std::endl;
+        stream << remainderLabel << ":" << std::endl;
+    }
+
+    void EmitLoop(std::ostream &stream, Context &context, int destReg, const PointerInductions &pointers) const {
+        std::string loopStartLabel = context.nameNewBranch();
+        std::string loopEndLabel = context.nameNewBranch();
+        stream << loopStartLabel << ":" << std::endl;
+        if (pointers.endRegister != -1){
+            EmitPointerExitTest(stream, context, pointers, 0, loopEndLabel);
+        }
+        else if (condition){
+            int conditionValueRegister = context.findFreeRegister();
+            condition->EmitRISC(stream, context, conditionValueRegister);
+            stream << "beq " << context.getRegisterName(conditionValueRegister) << ", zero, " << loopEndLabel << std::endl;
+            context.freeRegister(conditionValueRegister);
+        }
+        if (statement)
+            statement->EmitRISC(stream, context, destReg);
+        EmitIteration(stream, context, destReg, pointers);
+        EmitPointerUpdates(stream, context, pointers);
+        stream << "j " << loopStartLabel << std::endl;
+        stream << loopEndLabel << ":" << std::endl;
+    }
+
 public:
     ForLoop(Node* initialization_, Node* condition_, Node* iteration_, Node* statement_) : initialization(initialization_), condition(condition_), iteration(iteration_), statement(statement_) {}
     ~ForLoop(){
@@ -56,23 +512,88 @@ public:
         delete statement;
     }
 
+    std::vector<Node*> GetLoopParts() const {
+        return {condition, iteration, statement};
+    }
+
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
         if (initialization)
             initialization->EmitRISC(stream, context, destReg);
-        std::string loopStartLabel = context.nameNewBranch();
-        std::string loopEndLabel = context.nameNewBranch();
-        stream << loopStartLabel << ":" << std::endl;
-        int conditionValueRegister = context.findFreeRegister();
-        if (condition)
-            condition->EmitRISC(stream, context, conditionValueRegister);
-        stream << "beq " << context.getRegisterName(conditionValueRegister) << ", zero, " << loopEndLabel << std::endl;
-        if (statement)
-            statement->EmitRISC(stream, context, destReg);
-        if (iteration)
-            iteration->EmitRISC(stream, context, destReg);
-        stream << "j " << loopStartLabel << std::endl;
-        stream << loopEndLabel << ":" << std::endl;
-        context.freeRegister(conditionValueRegister);
+        EmitUnswitched(stream, context, destReg, 1);
+    }
+
+    void EmitLoopVersion(std::ostream &stream, Context &context, int destReg) const {
+        std::string variable, comparison;
+        int step;
+        Node *bound;
+        PointerInductions pointers;
+        if (!GetCountedLoop(context, variable, step, comparison, bound)){
+            std::vector<const Node*> hoisted = HoistInvariants(stream, context, GetLoopParts());
+            EmitLoop(stream, context, destReg, pointers);
+            ReleaseInvariants(context, hoisted);
+            return;
+        }
+
+        int bodySize = statement->CountNodes() + iteration->CountNodes();
+        int factor = context.getUnrollFactor();
+        std::string initialVariable;
+        int start, end, trips;
+        bool knownTrips = initialization && initialization->GetAssignedConstant(context, initialVariable, start) && initialVariable==variable
+                          && bound->GetConstantValue(context, end) && GetTripCount(start, step, comparison, end, trips);
+
+        if (knownTrips && trips<=maxFullUnrollTrips && trips*bodySize<=maxUnrolledNodes){
+            std::vector<const Node*> hoisted = HoistInvariants(stream, context, GetLoopParts());
+            EmitUnrolledIterations(stream, context, destReg, variable, start, step, trips);
+            ReleaseInvariants(context, hoisted);
+            return;
+        }
+
+        // A loop making calls keeps its induction variable in a saved register
+        // rather than reloading it from the stack after every call
+        int inductionRegister = -1;
+        if (statement->HasFunctionCall() && context.promotedRegister(variable) == -1){
+            inductionRegister = context.findFreeSavedRegister();
+        }
+        if (inductionRegister != -1){
+            EmitVariableLoad(stream, context, variable, inductionRegister);
+            context.promoteVariable(variable, inductionRegister);
+        }
+
+        // Pointers take priority over hoisting for the registers available.
+        // Once the exit test uses the end pointer, the condition is no longer
+        // evaluated inside the loop and has nothing worth hoisting.
+        EmitPointerInductions(stream, context, variable, step, comparison, bound, pointers);
+        std::vector<Node*> loopParts = GetLoopParts();
+        if (pointers.endRegister != -1){
+            loopParts = {statement};
+        }
+        std::vector<const Node*> hoisted = HoistInvariants(stream, context, loopParts);
+        if (factor>1 && factor*bodySize<=maxUnrolledNodes && (!knownTrips || trips>=factor)){
+            EmitUnrolledLoop(stream, context, destReg, variable, step, comparison, bound, factor, pointers);
+            if (knownTrips){
+                // The remaining iterations are known, so finish them without a loop
+                int remainder = trips % factor;
+                ReleasePointerInductions(stream, context, variable, pointers);
+                EmitUnrolledIterations(stream, context, destReg, variable, start + (trips-remainder)*step, step, remainder);
+            }
+            else{
+                EmitLoop(stream, context, destReg, pointers);
+            }
+        }
+        else{
+            EmitLoop(stream, context, destReg, pointers);
+        }
+        ReleasePointerInductions(stream, context, variable, pointers);
+        ReleaseInvariants(context, hoisted);
+        if (inductionRegister != -1){
+            context.demoteVariable(variable);
+            EmitVariableStore(stream, context, variable, inductionRegister);
+            context.freeRegister(inductionRegister);
+        }
+    }
+
+    std::vector<Node *> GetChildren() const {
+        return {initialization, condition, iteration, statement};
     }
 
     void Print(std::ostream &stream) const {
@@ -106,16 +627,30 @@ public:
     }
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        int conditionValue;
+        if (condition->GetConstantValue(context, conditionValue) || context.decidedCondition(condition, conditionValue)){
+            context.countStatistic("removed branches");
+            if (conditionValue && statement!=nullptr){
+                statement->EmitRISC(stream, context, destReg);
+            }
+            return;
+        }
         int conditionValueRegister = context.findFreeRegister();
 
         condition->EmitRISC(stream, context, conditionValueRegister);
         std::string falseBranch=context.nameNewBranch();
 
         stream<<"beq "<<context.getRegisterName(conditionValueRegister)<<", zero, "<<falseBranch<<std::endl;
+        // The condition is dead once tested, so the body can have its register
+        context.freeRegister(conditionValueRegister);
         statement->EmitRISC(stream, context, destReg);
         stream<<falseBranch<<":"<<std::endl;
-
-        context.freeRegister(conditionValueRegister);
+    }
+    std::vector<Node *> GetChildren() const {
+        return {condition, statement};
+    }
+    Node *GetBranchCondition() const {
+        return condition;
     }
     void Print(std::ostream &stream) const {
     }
@@ -160,6 +695,10 @@ public:
         stream<<"jr      ra"<<std::endl;
     }
 
+    std::vector<Node *> GetChildren() const {
+        return {expression, statements};
+    }
+
     void Print(std::ostream &stream) const {
     }
 };
@@ -182,6 +721,15 @@ public:
     }
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        int conditionValue;
+        if (condition->GetConstantValue(context, conditionValue) || context.decidedCondition(condition, conditionValue)){
+            context.countStatistic("removed branches");
+            Node *taken = conditionValue ? if_statement : else_statement;
+            if (taken!=nullptr){
+                taken->EmitRISC(stream, context, destReg);
+            }
+            return;
+        }
         int conditionValueRegister = context.findFreeRegister();
 
         condition->EmitRISC(stream, context, conditionValueRegister);
@@ -190,12 +738,18 @@ public:
         std::string continueBranch=context.nameNewBranch();
 
         stream<<"beq "<<context.getRegisterName(conditionValueRegister)<<", zero, "<<falseBranch<<std::endl;
+        context.freeRegister(conditionValueRegister);
         if_statement->EmitRISC(stream, context, destReg);
         stream<<"j "<<continueBranch<<std::endl;
         stream<<falseBranch<<":"<<std::endl;
         else_statement->EmitRISC(stream, context, destReg);
         stream<<continueBranch<<":"<<std::endl;
-        context.freeRegister(conditionValueRegister);
+    }
+    std::vector<Node *> GetChildren() const {
+        return {condition, if_statement, else_statement};
+    }
+    Node *GetBranchCondition() const {
+        return condition;
     }
     void Print(std::ostream &stream) const {
         stream<<"if(";
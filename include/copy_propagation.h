@@ -0,0 +1,14 @@
+#ifndef LANGPROC_COMPILER_COPY_PROPAGATION_H
+#define LANGPROC_COMPILER_COPY_PROPAGATION_H
+
+#include <vector>
+
+#include "assembly.h"
+
+// Remove register-to-register moves after allocation, working within basic
+// blocks. A move is removed either by reading its source directly wherever
+// the copy was read, or by having the instruction that produced the source
+// write straight into the destination. Returns the number of rewrites.
+int RunCopyPropagation(std::vector<AssemblyLine> &code);
+
+#endif
@@ -2,8 +2,149 @@
 #define FUNCTION_CALLER_HPP
 
 #include "node.hpp"
+#include "assembly.h"
 
-class FunctionCall : public Node
+// Common base for calls. Arguments go in a0-a7 and fa0-fa7, and the result
+// comes back in a0 or fa0. Temporaries still holding a value are caller-saved:
+// they are spilled to the frame around the call and reloaded after it, unless
+// the callee has been compiled already and is known to leave them alone.
+// Calls to const and pure functions can be hoisted out of loops and shared
+// between repeated calls with the same arguments.
+class Call : public Node
+{
+protected:
+    bool IsRepeatableCall(Context &context, std::string functionName, bool &readsMemory) const {
+        FunctionEffect effect = context.getFunctionEffect(functionName);
+        readsMemory = readsMemory || effect == PURE_FUNCTION;
+        return effect != SIDE_EFFECTS;
+    }
+
+    bool IsFloatType(std::string type) const {
+        return type=="float" || type=="double";
+    }
+
+    void EmitCall(std::ostream &stream, Context &context, int destReg, std::string functionName, std::vector<Node *> arguments) const {
+        // A specialized copy of the callee already has the constant arguments
+        // built in, so they are not passed
+        std::map<int, int> constantArguments, specializedArguments;
+        for (size_t i = 0; i < arguments.size(); i++){
+            int value;
+            if (arguments[i]->GetExpressionType(context)=="int" && !arguments[i]->HasSideEffects()
+                && arguments[i]->GetConstantValue(context, value)){
+                constantArguments[i] = value;
+            }
+        }
+        std::string specializedName;
+        std::string returnType = context.getFunctionType(functionName);
+        if (context.findSpecialization(functionName, constantArguments, specializedArguments, specializedName)){
+            std::vector<Node *> passedArguments;
+            for (size_t i = 0; i < arguments.size(); i++){
+                if (!specializedArguments.count(i)){
+                    passedArguments.push_back(arguments[i]);
+                }
+            }
+            functionName = specializedName;
+            arguments = passedArguments;
+            context.countStatistic("specialized calls");
+        }
+
+        // Arguments containing a call are evaluated into temporaries first,
+        // so the nested call cannot clobber argument registers already set
+        std::vector<int> argumentRegisters;
+        std::vector<int> argumentTemporaries(arguments.size(), -1);
+        int integerArguments = 0, floatArguments = 0;
+        for (auto argument : arguments){
+            bool floatArgument = IsFloatType(argument->GetExpressionType(context));
+            argumentRegisters.push_back(10 + (floatArgument ? floatArguments++ : integerArguments++));
+        }
+        for (size_t i = 0; i < arguments.size(); i++){
+            if (arguments[i]->HasFunctionCall()){
+                argumentTemporaries[i] = context.findFreeRegister();
+                arguments[i]->EmitRISC(stream, context, argumentTemporaries[i]);
+            }
+        }
+        for (size_t i = 0; i < arguments.size(); i++){
+            if (argumentTemporaries[i] == -1){
+                arguments[i]->EmitRISC(stream, context, argumentRegisters[i]);
+            }
+        }
+        for (size_t i = 0; i < arguments.size(); i++){
+            if (argumentTemporaries[i] != -1){
+                EmitMove(stream, context, arguments[i]->GetExpressionType(context), argumentRegisters[i], argumentTemporaries[i]);
+                context.freeRegister(argumentTemporaries[i]);
+            }
+        }
+
+        // Which bank a temporary's value is in is not tracked, so both the
+        // integer and the floating point register of that number are kept.
+        // The slots are only needed around this call, so every call shares
+        // the same ones.
+        std::set<std::string> clobbered;
+        if (!context.getFunctionClobbers(functionName, clobbered)){
+            for (auto &reg : CallerSavedRegisters()){
+                clobbered.insert(reg);
+            }
+        }
+        struct Spill
+        {
+            int reg;
+            int floatSlot;
+            int integerSlot;
+        };
+        std::vector<Spill> spills;
+        context.enterScope();
+        for (int reg : context.getUsedTemporaries()){
+            std::string name = context.getRegisterName(reg);
+            if (reg == destReg){
+                continue;
+            }
+            int floatSlot = clobbered.count("f" + name) ? context.allocateSpillSlot(8) : -1;
+            int integerSlot = clobbered.count(name) ? context.allocateSpillSlot(4) : -1;
+            if (floatSlot != -1 || integerSlot != -1){
+                spills.push_back({reg, floatSlot, integerSlot});
+            }
+        }
+        for (auto spill : spills){
+            context.countStatistic("spills", (spill.floatSlot != -1) + (spill.integerSlot != -1));
+            if (spill.floatSlot != -1){
+                EmitStore(stream, context, "double", spill.reg, spill.floatSlot);
+            }
+            if (spill.integerSlot != -1){
+                EmitStore(stream, context, "int", spill.reg, spill.integerSlot);
+            }
+        }
+
+        stream << "call " << functionName << std::endl;
+
+        for (auto spill : spills){
+            context.countStatistic("reloads", (spill.floatSlot != -1) + (spill.integerSlot != -1));
+            if (spill.floatSlot != -1){
+                EmitLoad(stream, context, "double", spill.reg, spill.floatSlot);
+            }
+            if (spill.integerSlot != -1){
+                EmitLoad(stream, context, "int", spill.reg, spill.integerSlot);
+            }
+        }
+        context.exitScope();
+        if (destReg != 10){
+            EmitMove(stream, context, returnType, destReg, 10);
+        }
+    }
+
+    void EmitMove(std::ostream &stream, Context &context, std::string type, int destReg, int sourceReg) const {
+        if (type=="float"){
+            stream << "fmv.s f" << context.getRegisterName(destReg) << ", f" << context.getRegisterName(sourceReg) << std::endl;
+        }
+        else if (type=="double"){
+            stream << "fmv.d f" << context.getRegisterName(destReg) << ", f" << context.getRegisterName(sourceReg) << std::endl;
+        }
+        else{
+            stream << "mv " << context.getRegisterName(destReg) << ", " << context.getRegisterName(sourceReg) << std::endl;
+        }
+    }
+};
+
+class FunctionCall : public Call
 {
 private:
     Node *expression;
@@ -15,21 +156,42 @@ public:
         delete expression;
     };
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        std::string functionName=expression->GetIdentifier();
-        context.callFunction();
-        stream<<"addi sp,sp,-16"<<std::endl;
-        stream<<"sw ra,12(sp)"<<std::endl;
-        stream<<"sw s0,8(sp)"<<std::endl;
-        stream<<"addi s0,sp,16"<<std::endl;
-        stream<<"call "<<functionName<<std::endl;
+        if (EmitHoisted(stream, context, destReg)){
+            return;
+        }
+        EmitCall(stream, context, destReg, expression->GetIdentifier(), {});
     }
     void Print(std::ostream &stream) const {
         std::string functionName=expression->GetIdentifier();
         stream<<functionName<<"()"<<std::endl;
     }
+    std::string GetExpressionType(Context &context) const {
+        return context.getFunctionType(expression->GetIdentifier());
+    }
+    bool HasSideEffects() const {
+        return true;
+    }
+    bool HasFunctionCall() const {
+        return true;
+    }
+    void GetCalledFunctions(std::set<std::string> &functions) const {
+        functions.insert(expression->GetIdentifier());
+        Node::GetCalledFunctions(functions);
+    }
+    bool IsRepeatable(Context &context, bool &readsMemory) const {
+        return IsRepeatableCall(context, expression->GetIdentifier(), readsMemory);
+    }
+    bool IsHoistable() const {
+        return true;
+    }
+    bool GetCall(std::string &function, std::vector<Node *> &arguments) const {
+        function = expression->GetIdentifier();
+        arguments.clear();
+        return true;
+    }
 };
 
-class FunctionCallWithArguments : public Node
+class FunctionCallWithArguments : public Call
 {
 private:
     Node *expression;
@@ -43,18 +205,41 @@ public:
         delete arguments;
     };
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        std::string functionName=expression->GetIdentifier();
-        context.callFunction();
-        arguments->EmitRISC(stream, context, destReg);
-        stream<<"addi sp,sp,-16"<<std::endl;
-        stream<<"sw ra,12(sp)"<<std::endl;
-        stream<<"sw s0,8(sp)"<<std::endl;
-        stream<<"addi s0,sp,16"<<std::endl;
-        stream<<"call "<<functionName<<std::endl;
+        if (EmitHoisted(stream, context, destReg)){
+            return;
+        }
+        EmitCall(stream, context, destReg, expression->GetIdentifier(), arguments->GetChildren());
     }
     void Print(std::ostream &stream) const {
 
     }
+    std::string GetExpressionType(Context &context) const {
+        return context.getFunctionType(expression->GetIdentifier());
+    }
+    std::vector<Node *> GetChildren() const {
+        return {arguments};
+    }
+    bool HasSideEffects() const {
+        return true;
+    }
+    bool HasFunctionCall() const {
+        return true;
+    }
+    void GetCalledFunctions(std::set<std::string> &functions) const {
+        functions.insert(expression->GetIdentifier());
+        Node::GetCalledFunctions(functions);
+    }
+    bool IsRepeatable(Context &context, bool &readsMemory) const {
+        return IsRepeatableCall(context, expression->GetIdentifier(), readsMemory) && Node::IsRepeatable(context, readsMemory);
+    }
+    bool IsHoistable() const {
+        return true;
+    }
+    bool GetCall(std::string &function, std::vector<Node *> &arguments_) const {
+        function = expression->GetIdentifier();
+        arguments_ = arguments->GetChildren();
+        return true;
+    }
 };
 
 
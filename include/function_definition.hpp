@@ -1,7 +1,11 @@
 #ifndef FUNCTION_DEFINITION_HPP
 #define FUNCTION_DEFINITION_HPP
 
+#include <map>
+#include <sstream>
+
 #include "node.hpp"
+#include "assembly.h"
 
 class FunctionDefinition : public Node
 {
@@ -10,6 +14,97 @@ private:
     Node *declarator_;
     Node *compound_statement_;
 
+    // Caller-saved registers the body writes, directly or through the
+    // functions it calls
+    std::set<std::string> GetClobberedRegisters(Context &context, const std::string &body) const {
+        std::set<std::string> clobbered;
+        std::stringstream text(body);
+        for (auto &line : ParseAssembly(text)){
+            std::set<std::string> calleeClobbers;
+            if (!line.isCall()){
+                std::string written = line.definedRegister();
+                if (IsCallerSaved(written)){
+                    clobbered.insert(written);
+                }
+            }
+            else if (!line.operands.empty() && context.getFunctionClobbers(line.operands[0], calleeClobbers)){
+                clobbered.insert(calleeClobbers.begin(), calleeClobbers.end());
+                clobbered.insert("ra");
+            }
+            else{
+                for (auto &reg : CallerSavedRegisters()){
+                    clobbered.insert(reg);
+                }
+            }
+        }
+        return clobbered;
+    }
+
+    // The body is compiled first, since the frame size and the saved
+    // registers the prologue has to deal with are only known afterwards.
+    // Frame layout, from the frame pointer s0 (the caller's sp) down:
+    //   -4(s0) ra, -8(s0) old s0, locals and spill slots, then the saved
+    //   registers at the bottom, from 0(sp) up.
+    void EmitFunction(std::ostream &stream, Context &context, int destReg, std::string functionName, const std::map<int, int> &constants) const {
+        context.beginFunction(functionName, declaration_specifiers_->GetType());
+        context.declareFunction(functionName);
+        std::vector<const Node *> parameters;
+        GetParameters(parameters);
+        for (auto &constant : constants){
+            context.setParameterValue(parameters[constant.first]->GetIdentifier(), constant.second);
+        }
+
+        std::stringstream body;
+        declarator_->EmitRISC(body, context, destReg);
+        if (compound_statement_ != nullptr){
+            compound_statement_->EmitRISC(body, context, destReg);
+        }
+
+        context.setFunctionClobbers(functionName, GetClobberedRegisters(context, body.str()));
+
+        int frameSize = context.getFrameSize();
+        std::set<int> savedRegisters = context.getUsedSavedRegisters();
+        // Functions the profile saw never run go with the other unlikely code
+        bool cold = context.isColdFunction(functionName);
+        if (context.getFunctionSections()){
+            stream << ".section .text." << (cold ? "unlikely." : "") << functionName << ",\"ax\",@progbits" << std::endl;
+            stream << ".align 2" << std::endl;
+        }
+        else if (cold){
+            stream << ".section .text.unlikely,\"ax\",@progbits" << std::endl;
+            stream << ".align 2" << std::endl;
+        }
+        if (constants.empty() && !context.isInternalFunction(declarator_->GetIdentifier())){
+            stream << ".globl " << functionName << std::endl;
+        }
+        stream << functionName << ":" << std::endl;
+        stream << "addi sp, sp, " << -frameSize << std::endl;
+        stream << "sw ra, " << frameSize-4 << "(sp)" << std::endl;
+        stream << "sw s0, " << frameSize-8 << "(sp)" << std::endl;
+        int savedLocation = 0;
+        for (int reg : savedRegisters){
+            stream << "sw " << context.getRegisterName(reg) << ", " << savedLocation << "(sp)" << std::endl;
+            savedLocation += 4;
+        }
+        stream << "addi s0, sp, " << frameSize << std::endl;
+
+        stream << body.str();
+
+        stream << context.getReturnLabel() << ":" << std::endl;
+        savedLocation = 0;
+        for (int reg : savedRegisters){
+            stream << "lw " << context.getRegisterName(reg) << ", " << savedLocation << "(sp)" << std::endl;
+            savedLocation += 4;
+        }
+        stream << "lw ra, " << frameSize-4 << "(sp)" << std::endl;
+        stream << "lw s0, " << frameSize-8 << "(sp)" << std::endl;
+        stream << "addi sp, sp, " << frameSize << std::endl;
+        stream << "jr ra" << std::endl;
+        if (cold && !context.getFunctionSections()){
+            stream << ".text" << std::endl;
+        }
+    }
+
 public:
     FunctionDefinition(Node *declaration_specifiers, Node *declarator, Node *compound_statement) : declaration_specifiers_(declaration_specifiers), declarator_(declarator), compound_statement_(compound_statement){}
     ~FunctionDefinition(){
@@ -18,12 +113,30 @@ public:
         delete compound_statement_;
     }
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        if(declarator_ != nullptr){
-            declarator_->EmitRISC(stream, context, destReg);
-        }
-        if (compound_statement_ != nullptr){
-            compound_statement_->EmitRISC(stream, context, destReg);
-        }
+        EmitFunction(stream, context, destReg, declarator_->GetIdentifier(), {});
+    }
+    // A copy of the function for calls passing the given constant integer
+    // arguments. It is local to this file and leaves those parameters out.
+    void EmitSpecialization(std::ostream &stream, Context &context, int destReg, std::string name, const std::map<int, int> &constants) const {
+        EmitFunction(stream, context, destReg, name, constants);
+    }
+    std::string GetIdentifier() const {
+        return declarator_->GetIdentifier();
+    }
+    std::string GetStorageClass() const {
+        return declaration_specifiers_->GetStorageClass();
+    }
+    std::string GetReturnType() const {
+        return declaration_specifiers_->GetType();
+    }
+    bool IsFunctionDefinition() const {
+        return true;
+    }
+    std::vector<Node *> GetChildren() const {
+        return {compound_statement_};
+    }
+    void GetParameters(std::vector<const Node *> &parameters) const {
+        declarator_->GetParameters(parameters);
     }
     void Print(std::ostream &stream) const {
         //comment out for extra passed test case
@@ -43,26 +156,46 @@ public:
     }
 };
 
+// A function declaration without a body: only its return type is recorded,
+// and whether `__attribute__((const))` or `__attribute__((pure))` says calls
+// to it can be shared or hoisted
 class EmptyFunctionDefinition : public Node
 {
 private:
-    Node *declarator_;
     Node *specifier_;
+    Node *declarator_;
+    std::string attribute_;
 
 public:
-    EmptyFunctionDefinition(Node *declarator, Node *specifier) : declarator_(declarator), specifier_(specifier){};
+    EmptyFunctionDefinition(Node *specifier, Node *declarator, std::string attribute="") : specifier_(specifier), declarator_(declarator), attribute_(attribute){};
     ~EmptyFunctionDefinition()
     {
-        delete declarator_;
         delete specifier_;
+        delete declarator_;
     };
-    void EmitRISC(std::ostream &stream, Context &context, int destReg) const override {}
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const override {
+        std::string functionName = declarator_->GetIdentifier();
+        context.setFunctionType(functionName, specifier_->GetType());
+        context.declareFunction(functionName);
+        if (specifier_->GetStorageClass()=="static"){
+            context.setInternalFunction(functionName);
+        }
+        if (attribute_=="const" || attribute_=="__const__"){
+            context.setFunctionEffect(functionName, CONST_FUNCTION);
+        }
+        else if (attribute_=="pure" || attribute_=="__pure__"){
+            context.setFunctionEffect(functionName, PURE_FUNCTION);
+        }
+    }
     void Print(std::ostream &stream) const {
-        declarator_->Print(stream);
-        stream<<" ";
         specifier_->Print(stream);
+        stream<<" ";
+        declarator_->Print(stream);
         stream<<"();"<<std::endl;
     }
+    std::string GetIdentifier() const {
+        return declarator_->GetIdentifier();
+    }
 };
 
 class FunctionWithParamDefinition : public Node
@@ -78,27 +211,18 @@ public:
         delete declarator;
         delete parameters;
     };
+    // Store the incoming arguments to the parameters' stack slots
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-        std::string functionName=declarator->GetIdentifier();
-        if(context.isFunctionDeclared(functionName)){
+        if(parameters!=nullptr){
             parameters->EmitRISC(stream, context, destReg);
-            context.callFunction();
-            stream<<"addi sp,sp,-16"<<std::endl;
-            stream<<"sw ra,12(sp)"<<std::endl;
-            stream<<"sw s0,8(sp)"<<std::endl;
-            stream<<"addi s0,sp,16"<<std::endl;
-            stream<<"call "<<functionName<<std::endl;
-        }
-        else{
-            context.declareFunction(functionName);
-            stream << ".globl ";
-            declarator->EmitRISC(stream, context, destReg);
-            stream<<std::endl;
-            declarator->EmitRISC(stream, context, destReg);
-            stream << ":" << std::endl;
-            if(parameters!=nullptr){
-                parameters->EmitRISC(stream, context, destReg);
-            }
+        }
+    }
+    std::string GetIdentifier() const {
+        return declarator->GetIdentifier();
+    }
+    void GetParameters(std::vector<const Node *> &parameters_) const {
+        if(parameters!=nullptr){
+            parameters->GetParameters(parameters_);
         }
     }
     void Print(std::ostream &stream) const {
@@ -122,10 +246,14 @@ public:
         delete parameter_list;
         delete parameter_declaration;
     };
+    // Parameters are bound in order, so the earlier ones come first
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
-
-        parameter_declaration->EmitRISC(stream, context, destReg);
         parameter_list->EmitRISC(stream, context, destReg);
+        parameter_declaration->EmitRISC(stream, context, destReg);
+    }
+    void GetParameters(std::vector<const Node *> &parameters) const {
+        parameter_list->GetParameters(parameters);
+        parameter_declaration->GetParameters(parameters);
     }
     void Print(std::ostream &stream) const {
         parameter_declaration->Print(stream);
@@ -147,23 +275,30 @@ public:
         delete declaration_specifier;
         delete declarator;
     };
+    // A parameter fixed by a specialization is not passed: its value is
+    // known instead
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
 
         std::string variableType = declaration_specifier->GetType();
         std::string variableName = declarator->GetIdentifier();
 
         int variableAddress = context.bindVariable(variableName, variableType);
-        int parameterRegister = context.findFreeParamRegister();
-
-        if(variableType=="float"){
-            stream<<"fsw f"<<context.getRegisterName(parameterRegister)<<", " <<variableAddress<<"(sp)"<<std::endl;
-        }
-        else if (variableType=="double"){
-            stream<<"fsd f"<<context.getRegisterName(parameterRegister)<<", " <<variableAddress<<"(sp)"<<std::endl;
-        }
-        else{
-             stream<<"sw "<<context.getRegisterName(parameterRegister)<<", "<<variableAddress<<"(sp)"<<std::endl;
+        int value;
+        if (context.parameterValue(variableName, value)){
+            context.setKnownValue(variableName, value);
+            return;
         }
+        int parameterRegister = context.nextParameterRegister(variableType);
+        EmitStore(stream, context, variableType, parameterRegister, variableAddress);
+    }
+    std::string GetIdentifier() const {
+        return declarator->GetIdentifier();
+    }
+    std::string GetType() const {
+        return declaration_specifier->GetType();
+    }
+    void GetParameters(std::vector<const Node *> &parameters) const {
+        parameters.push_back(this);
     }
     void Print(std::ostream &stream) const {
         declaration_specifier->Print(stream);
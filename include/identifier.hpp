@@ -32,21 +32,21 @@ public:
     VariableIdentifier(std::string identifier) : identifier_(identifier){};
     ~VariableIdentifier(){};
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        if (EmitHoisted(stream, context, destReg)){
+            return;
+        }
+        int value;
+        if (context.knownValue(identifier_, value)){
+            stream << "li " << context.getRegisterName(destReg) << ", " << value << std::endl;
+            return;
+        }
         int currentStackLocation = context.variableLocation(identifier_);
-        if (currentStackLocation!=-1){
-            std::string variableType=context.getVariableType(identifier_);
-            if(variableType=="double"){
-                stream<<"fld f"<<context.getRegisterName(destReg)<<", "<<currentStackLocation<< "(sp)"<<std::endl;
-            }
-            else if (variableType=="float"){
-                stream<<"flw f"<<context.getRegisterName(destReg)<<", "<<currentStackLocation<<"(sp)"<<std::endl;
-            }
-            else if(variableType=="char"){
-                stream<<"lb "<<context.getRegisterName(destReg)<<", "<<currentStackLocation<<"(sp)"<<std::endl;
-            }
-            else {
-                stream<<"lw "<<context.getRegisterName(destReg)<<", "<<currentStackLocation<<"(sp)"<<std::endl;
-            }
+        if (context.isArray(identifier_)){
+            // An array used as a value decays to the address of its first element
+            stream << "addi " << context.getRegisterName(destReg) << ", s0, " << currentStackLocation << std::endl;
+        }
+        else if (currentStackLocation!=-1){
+            EmitVariableLoad(stream, context, identifier_, destReg);
         }
     }
     void Print(std::ostream &stream) const {
@@ -55,6 +55,25 @@ public:
     std::string GetIdentifier() const{
         return identifier_;
     }
+    std::string GetExpressionType(Context &context) const {
+        return context.getVariableType(identifier_);
+    }
+    void GetReadVariables(std::set<std::string> &variables) const {
+        variables.insert(identifier_);
+    }
+    bool IsHoistable() const {
+        return true;
+    }
+    bool IsVariable() const {
+        return true;
+    }
+    bool GetConstantValue(Context &context, int &value) const {
+        return context.knownValue(identifier_, value);
+    }
+    bool GetOffset(Context &context, const std::string &variable, int &offset) const {
+        offset = 0;
+        return identifier_==variable;
+    }
 };
 
 #endif
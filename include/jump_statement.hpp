@@ -16,17 +16,12 @@ public:
     };
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        // The result goes in a0 (fa0 for floating point) and the epilogue
+        // restores the frame
         if (expression_ != nullptr){
-            expression_->EmitRISC(stream, context, destReg);
+            expression_->EmitRISC(stream, context, 10);
         }
-        if(context.isFunctionCalled()){
-            context.uncallFunction();
-            stream<<"lw ra, 12(sp)"<<std::endl;
-            stream<<"lw s0, 8(sp)"<<std::endl;
-            stream<<"addi sp, sp, 16"<<std::endl;
-        }
-        stream<<"lw      s0,28(sp)"<<std::endl;
-        stream << "jr ra" << std::endl;
+        stream << "j " << context.getReturnLabel() << std::endl;
     }
     void Print(std::ostream &stream) const {
         stream << "return";
@@ -36,6 +31,9 @@ public:
         }
         stream << ";" << std::endl;
     }
+    std::vector<Node *> GetChildren() const {
+        return {expression_};
+    }
 };
 
 #endif
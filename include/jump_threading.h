@@ -0,0 +1,16 @@
+#ifndef LANGPROC_COMPILER_JUMP_THREADING_H
+#define LANGPROC_COMPILER_JUMP_THREADING_H
+
+#include <vector>
+
+#include "assembly.h"
+
+// Shorten chains of branches. A branch or jump to another jump goes straight
+// to its final target. When the values a block tests are known on an edge
+// into it, e.g. from `li t0, 0` just before the jump, the edge goes straight
+// to the outcome, taking a copy of the few instructions in front of the test
+// with it. Code left with no way in is removed. Returns the number of
+// rewrites.
+int RunJumpThreading(std::vector<AssemblyLine> &code);
+
+#endif
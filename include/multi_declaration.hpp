@@ -19,12 +19,11 @@ public:
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const{
         if(declarator!=nullptr){
-            declarator->EmitRISC(stream, context, destReg);
+            std::string variableType = specifier->GetType();
+            for (auto initDeclarator : declarator->GetChildren()){
+                initDeclarator->EmitDeclaration(stream, context, variableType);
+            }
         }
-        if(specifier!=nullptr){
-            specifier->EmitRISC(stream, context, destReg);
-        }
-
     }
     void Print(std::ostream &stream) const {
         if(specifier!=nullptr){
@@ -34,6 +33,9 @@ public:
             declarator->Print(stream);
         }
     }
+    std::vector<Node *> GetChildren() const {
+        return {specifier, declarator};
+    }
 };
 
 class SingleDeclarator : public Node
@@ -53,23 +55,18 @@ public:
         std::string variableType = specifier->GetType();
         std::string variableName = declarator->GetIdentifier();
         int currentStackLocation = context.bindVariable(variableName, variableType);
-        if(variableType=="float"){
-            stream<<"fsw f"<<context.getRegisterName(destReg)<<", " <<currentStackLocation<<"(sp)"<<std::endl;
-        }
-        else if(variableType=="double"){
-            stream<<"fsd f"<<context.getRegisterName(destReg)<<", " <<currentStackLocation<<"(sp)"<<std::endl;
-        }
-        else if(variableType=="int"){
-            stream<<"sw "<<context.getRegisterName(destReg)<<", "<<currentStackLocation<<"(sp)"<<std::endl;
-        }
-        else if(variableType=="char"){
-            stream<<"sb "<<context.getRegisterName(destReg)<<", "<<currentStackLocation<<"(sp)"<<std::endl;
-        }
+        EmitStore(stream, context, variableType, destReg, currentStackLocation);
     }
     void Print(std::ostream &stream) const {
         specifier->Print(stream);
         declarator->Print(stream);
     }
+    std::vector<Node *> GetChildren() const {
+        return {specifier, declarator};
+    }
+    void GetWrittenVariables(std::set<std::string> &variables) const {
+        variables.insert(declarator->GetIdentifier());
+    }
 };
 
 #endif
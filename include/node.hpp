@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <vector>
+#include <set>
+#include <string>
 
 #include "context.hpp"
 
@@ -26,9 +28,307 @@ public:
     virtual std::string GetType() const {
         std::cerr<<"Type Error"<<std::endl;
     }
+    // `static`, `extern`, ... for declaration specifiers, or "" if there is none
+    virtual std::string GetStorageClass() const {
+        return "";
+    }
     virtual int GetSize() const{
         std::cerr<<"Size Error"<<std::endl;
     }
+
+    // Type of the value an expression evaluates to ("int", "float", "double", ...)
+    virtual std::string GetExpressionType(Context &context) const {
+        return "int";
+    }
+
+    // Child nodes, used by the analyses below that walk the tree
+    virtual std::vector<Node *> GetChildren() const {
+        return branches;
+    }
+
+    // Variables assigned to or declared anywhere in this subtree
+    virtual void GetWrittenVariables(std::set<std::string> &variables) const {
+        for (auto child : GetChildren()){
+            if (child != nullptr){
+                child->GetWrittenVariables(variables);
+            }
+        }
+    }
+
+    // Variables read anywhere in this subtree
+    virtual void GetReadVariables(std::set<std::string> &variables) const {
+        for (auto child : GetChildren()){
+            if (child != nullptr){
+                child->GetReadVariables(variables);
+            }
+        }
+    }
+
+    // Whether evaluating this subtree can change state other than its result
+    virtual bool HasSideEffects() const {
+        for (auto child : GetChildren()){
+            if (child != nullptr && child->HasSideEffects()){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    virtual bool HasFunctionCall() const {
+        for (auto child : GetChildren()){
+            if (child != nullptr && child->HasFunctionCall()){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Functions called anywhere in this subtree
+    virtual void GetCalledFunctions(std::set<std::string> &functions) const {
+        for (auto child : GetChildren()){
+            if (child != nullptr){
+                child->GetCalledFunctions(functions);
+            }
+        }
+    }
+
+    // A function with a body, as opposed to a declaration
+    virtual bool IsFunctionDefinition() const {
+        return false;
+    }
+    // Name and argument expressions of a call
+    virtual bool GetCall(std::string &function, std::vector<Node *> &arguments) const {
+        return false;
+    }
+    // Parameter declarations of a function, in order
+    virtual void GetParameters(std::vector<const Node *> &parameters) const {}
+
+    // Expressions that are worth computing once in a loop preheader when invariant
+    virtual bool IsHoistable() const {
+        return false;
+    }
+
+    virtual bool IsVariable() const {
+        return false;
+    }
+
+    // Sethi-Ullman number: registers needed to evaluate this expression,
+    // counting the one that receives its value
+    virtual int GetRegisterNeed(Context &context) const {
+        return 1;
+    }
+
+    // Value of an integer expression if it can be worked out at compile time
+    virtual bool GetConstantValue(Context &context, int &value) const {
+        return false;
+    }
+
+    // Number of nodes in this subtree, used as a code size estimate
+    int CountNodes() const {
+        int nodes = 1;
+        for (auto child : GetChildren()){
+            if (child != nullptr){
+                nodes += child->CountNodes();
+            }
+        }
+        return nodes;
+    }
+
+    // Loop shape queries, used to recognise counted loops
+    // `i = c`
+    virtual bool GetAssignedConstant(Context &context, std::string &variable, int &value) const {
+        return false;
+    }
+    // `i++`, `i--`, `i = i + c`, `i += c`
+    virtual bool GetIncrement(Context &context, std::string &variable, int &step) const {
+        return false;
+    }
+    // `i + c`, `i - c`
+    virtual bool GetOffset(Context &context, const std::string &variable, int &offset) const {
+        return false;
+    }
+    // `i < bound` and the other relational operators
+    virtual bool GetLoopBound(std::string &variable, std::string &comparison, Node *&bound) const {
+        return false;
+    }
+
+    // `array[index]`, used to find array accesses that follow an induction variable
+    virtual bool GetArrayAccess(std::string &array, Node *&index) const {
+        return false;
+    }
+    // Number of elements of an array declarator
+    virtual bool GetArrayLength(Context &context, int &length) const {
+        return false;
+    }
+    // Store valueReg to the array element this expression designates; returns
+    // false for plain variables, which the caller stores itself
+    virtual bool EmitElementStore(std::ostream &stream, Context &context, int valueReg) const {
+        return false;
+    }
+
+    // Condition of an if statement, used to find branches that can be unswitched
+    virtual Node *GetBranchCondition() const {
+        return nullptr;
+    }
+
+    // Declare the variable introduced by this declarator with the given type
+    virtual void EmitDeclaration(std::ostream &stream, Context &context, std::string type) const {}
+
+    // Whether evaluating this subtree again gives the same result and has no
+    // other effect: it has no side effects and only calls const and pure
+    // functions. readsMemory is set if it calls a pure function, whose result
+    // also depends on memory that calls to other functions can change.
+    virtual bool IsRepeatable(Context &context, bool &readsMemory) const {
+        if (!HasFunctionCall()){
+            return !HasSideEffects();
+        }
+        for (auto child : GetChildren()){
+            if (child != nullptr && !child->IsRepeatable(context, readsMemory)){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // An expression is loop invariant if it is repeatable and none of the
+    // variables it reads are written inside the loop. Variables only live in
+    // their own stack slots, so a load can only alias a store to the same name.
+    // Calls to pure functions are only invariant if the loop calls no function
+    // with side effects.
+    bool IsLoopInvariant(Context &context, const std::set<std::string> &loopWrites, bool loopWritesMemory) const {
+        bool readsMemory = false;
+        if (!IsRepeatable(context, readsMemory) || (readsMemory && loopWritesMemory)){
+            return false;
+        }
+        std::set<std::string> reads;
+        GetReadVariables(reads);
+        for (auto &variable : reads){
+            if (loopWrites.count(variable)){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Collect the largest loop-invariant subexpressions of this subtree
+    void FindLoopInvariants(Context &context, const std::set<std::string> &loopWrites, bool loopWritesMemory, std::vector<const Node *> &invariants) const {
+        if (IsHoistable() && IsLoopInvariant(context, loopWrites, loopWritesMemory)){
+            invariants.push_back(this);
+            return;
+        }
+        for (auto child : GetChildren()){
+            if (child != nullptr){
+                child->FindLoopInvariants(context, loopWrites, loopWritesMemory, invariants);
+            }
+        }
+    }
+
+    // Collect the calls in this subtree
+    void FindCalls(std::vector<const Node *> &calls) const {
+        std::string function;
+        std::vector<Node *> arguments;
+        if (GetCall(function, arguments)){
+            calls.push_back(this);
+        }
+        for (auto child : GetChildren()){
+            if (child != nullptr){
+                child->FindCalls(calls);
+            }
+        }
+    }
+
+    // Whether this subtree calls a function that may write memory
+    bool CallsFunctionWithSideEffects(Context &context) const {
+        std::vector<const Node *> calls;
+        FindCalls(calls);
+        for (auto call : calls){
+            std::string function;
+            std::vector<Node *> arguments;
+            call->GetCall(function, arguments);
+            if (context.getFunctionEffect(function) == SIDE_EFFECTS){
+                return true;
+            }
+        }
+        return false;
+    }
+
+protected:
+    // Load or store a variable of the given type from/to its stack slot, which
+    // is addressed from the frame pointer, or from/to an offset from another
+    // base register
+    void EmitLoad(std::ostream &stream, Context &context, std::string type, int reg, int location, std::string base="s0") const {
+        if(type=="double"){
+            stream<<"fld f"<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+        else if (type=="float"){
+            stream<<"flw f"<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+        else if(type=="char"){
+            stream<<"lb "<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+        else if(type=="short"){
+            stream<<"lh "<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+        else {
+            stream<<"lw "<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+    }
+    void EmitStore(std::ostream &stream, Context &context, std::string type, int reg, int location, std::string base="s0") const {
+        if (type=="float"){
+            stream<<"fsw f"<<context.getRegisterName(reg)<<", " <<location<<"("<<base<<")"<<std::endl;
+        }
+        else if(type=="double"){
+            stream<<"fsd f"<<context.getRegisterName(reg)<<", " <<location<<"("<<base<<")"<<std::endl;
+        }
+        else if(type=="char"){
+            stream<<"sb "<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+        else if(type=="short"){
+            stream<<"sh "<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+        else{
+            stream<<"sw "<<context.getRegisterName(reg)<<", "<<location<<"("<<base<<")"<<std::endl;
+        }
+    }
+
+    // Read or write a named variable, in the register it has been promoted to
+    // if there is one
+    void EmitVariableLoad(std::ostream &stream, Context &context, std::string name, int reg) const {
+        int promotedRegister = context.promotedRegister(name);
+        if (promotedRegister != -1){
+            stream<<"mv "<<context.getRegisterName(reg)<<", "<<context.getRegisterName(promotedRegister)<<std::endl;
+            return;
+        }
+        EmitLoad(stream, context, context.getVariableType(name), reg, context.variableLocation(name));
+    }
+    void EmitVariableStore(std::ostream &stream, Context &context, std::string name, int reg) const {
+        int promotedRegister = context.promotedRegister(name);
+        if (promotedRegister != -1){
+            stream<<"mv "<<context.getRegisterName(promotedRegister)<<", "<<context.getRegisterName(reg)<<std::endl;
+            return;
+        }
+        EmitStore(stream, context, context.getVariableType(name), reg, context.variableLocation(name));
+    }
+
+    // If this expression was hoisted out of the enclosing loop, copy its value
+    // from the preheader register instead of evaluating it again.
+    bool EmitHoisted(std::ostream &stream, Context &context, int destReg) const {
+        int hoistedRegister = context.hoistedRegister(this);
+        if (hoistedRegister == -1){
+            return false;
+        }
+        std::string type = GetExpressionType(context);
+        if (type == "float"){
+            stream << "fmv.s f" << context.getRegisterName(destReg) << ", f" << context.getRegisterName(hoistedRegister) << std::endl;
+        }
+        else if (type == "double"){
+            stream << "fmv.d f" << context.getRegisterName(destReg) << ", f" << context.getRegisterName(hoistedRegister) << std::endl;
+        }
+        else{
+            stream << "mv " << context.getRegisterName(destReg) << ", " << context.getRegisterName(hoistedRegister) << std::endl;
+        }
+        return true;
+    }
 };
 
 class NodeList : public Node
@@ -73,6 +373,10 @@ public:
     int getSize() const {
         return nodes.size();
     }
+
+    std::vector<Node *> GetChildren() const {
+        return nodes;
+    }
 };
 
 #endif
@@ -0,0 +1,23 @@
+#ifndef LANGPROC_COMPILER_PEEPHOLE_H
+#define LANGPROC_COMPILER_PEEPHOLE_H
+
+#include <vector>
+
+#include "assembly.h"
+
+// A peephole rule looks at a small window of code starting at position i and
+// rewrites it in place, returning true if it changed anything.
+struct PeepholeRule
+{
+    const char *name;
+    bool (*apply)(std::vector<AssemblyLine> &code, size_t i);
+};
+
+// Apply the rule table until no rule matches. Returns the number of rewrites.
+int RunPeephole(std::vector<AssemblyLine> &code);
+
+// Whether reg is certainly overwritten or unused after position i, following
+// branches and jumps to the blocks they reach and looking past calls
+bool IsDeadAfter(const std::vector<AssemblyLine> &code, size_t i, const std::string &reg);
+
+#endif
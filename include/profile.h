@@ -0,0 +1,27 @@
+#ifndef LANGPROC_COMPILER_PROFILE_H
+#define LANGPROC_COMPILER_PROFILE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "assembly.h"
+
+// Times each basic block of each function ran, numbered as the block layout
+// pass numbers them, from runs of a program built with -fprofile-generate.
+// Block 0 is the entry, so its count is the number of calls.
+struct Profile
+{
+    std::map<std::string, std::vector<long long>> blockCounts;
+};
+
+// Read the counts written by instrumented programs, adding up the runs.
+// Returns false if there is no profile at path.
+bool ReadProfile(const std::string &path, Profile &profile);
+
+// Count how often each basic block runs. Each block starts by incrementing
+// its counter, leaving every register as it was, and the program appends
+// the counts to path when it exits. Returns the number of counters.
+int RunProfileInstrumentation(std::vector<AssemblyLine> &code, const std::string &path);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef LANGPROC_COMPILER_SCHEDULER_H
+#define LANGPROC_COMPILER_SCHEDULER_H
+
+#include <string>
+#include <vector>
+
+#include "assembly.h"
+
+// Kinds of instruction that differ in latency or in the unit executing them
+enum OperationClass
+{
+    INTEGER_OPERATION,
+    LOAD_OPERATION,
+    STORE_OPERATION,
+    MULTIPLY_OPERATION,
+    DIVIDE_OPERATION,
+    FLOAT_ADD_OPERATION,
+    FLOAT_MULTIPLY_OPERATION,
+    FLOAT_DIVIDE_OPERATION,
+    FLOAT_MOVE_OPERATION,
+    BRANCH_OPERATION,
+    OPERATION_CLASSES,
+};
+
+enum FunctionalUnit
+{
+    INTEGER_UNIT,
+    MEMORY_UNIT,
+    MULTIPLY_UNIT,
+    FLOAT_UNIT,
+    FUNCTIONAL_UNITS,
+};
+
+struct OperationTiming
+{
+    int latency;         // Cycles until the result can be used
+    FunctionalUnit unit;
+    int occupancy;       // Cycles the unit is busy; 1 if it is pipelined
+};
+
+// Issue width, number of each functional unit, and timing of each class of
+// instruction for one core
+struct PipelineModel
+{
+    const char *name;
+    int issueWidth;
+    int unitCount[FUNCTIONAL_UNITS];
+    OperationTiming timing[OPERATION_CLASSES];
+};
+
+// Model with the given name, or nullptr if there is none
+const PipelineModel *FindPipelineModel(const std::string &name);
+
+// Reorder the instructions of each basic block to hide latencies on the given
+// core. Returns the number of instructions that moved.
+int RunScheduler(std::vector<AssemblyLine> &code, const PipelineModel &model);
+
+#endif
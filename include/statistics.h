@@ -0,0 +1,71 @@
+#ifndef LANGPROC_COMPILER_STATISTICS_H
+#define LANGPROC_COMPILER_STATISTICS_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "assembly.h"
+
+// Clocks and heap allocation counters of the calling thread at one moment.
+// Allocations are counted by the replacement operator new.
+struct ResourceSnapshot
+{
+    double wallSeconds;
+    double cpuSeconds;
+    long long allocations;
+    long long allocatedBytes;
+};
+
+ResourceSnapshot TakeSnapshot();
+
+// What one phase of a compilation cost, added up over every time it ran
+struct PhaseTiming
+{
+    std::string name;
+    double wallSeconds = 0;
+    double cpuSeconds = 0;
+    long long allocations = 0;
+    long long allocatedBytes = 0;
+
+    void add(const ResourceSnapshot &start, const ResourceSnapshot &end);
+    void add(const PhaseTiming &other);
+    void subtract(const PhaseTiming &other);
+};
+
+// Measurements of one compilation for -ftime-report and -stats. Phases are
+// kept in the order they first ran.
+struct CompilationStatistics
+{
+    bool timing = false; // Whether phases are timed at all
+    std::vector<PhaseTiming> phases;
+    std::map<std::string, long long> counters;
+    std::map<std::string, long long> opcodes; // Instructions written out, by opcode
+
+    PhaseTiming &phase(const std::string &name);
+    void countOpcodes(const std::vector<AssemblyLine> &code);
+    // Add up what another thread measured of the same compilation
+    void add(const CompilationStatistics &other);
+};
+
+// Adds the cost of the enclosing scope to a phase, if the statistics time
+// phases at all
+class PhaseTimer
+{
+public:
+    PhaseTimer(CompilationStatistics &statistics, const std::string &name);
+    ~PhaseTimer();
+
+private:
+    CompilationStatistics &statistics;
+    std::string name;
+    ResourceSnapshot start;
+};
+
+void WriteTimeReport(std::ostream &output, const CompilationStatistics &statistics);
+void WriteStatistics(std::ostream &output, const CompilationStatistics &statistics);
+// Both reports in one JSON object, for tools that track them over time
+void WriteStatisticsJson(std::ostream &output, const CompilationStatistics &statistics, const std::string &source);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef LANGPROC_COMPILER_TASK_GRAPH_H
+#define LANGPROC_COMPILER_TASK_GRAPH_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Run tasks 0 to dependencies.size() - 1 on a pool of threads, each one
+// once all the tasks it depends on have finished. Every thread keeps the
+// tasks it made ready in a queue of its own, starting on the newest, and
+// takes the oldest task of another thread's queue when its own is empty.
+// The calling thread is one of the threads. The dependencies must not form
+// a cycle.
+void RunTaskGraph(const std::vector<std::vector<size_t>> &dependencies, size_t threads, const std::function<void(size_t)> &run);
+
+#endif
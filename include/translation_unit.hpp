@@ -0,0 +1,390 @@
+#ifndef TRANSLATION_UNIT_HPP
+#define TRANSLATION_UNIT_HPP
+
+#include <cctype>
+#include <map>
+#include <sstream>
+
+#include "node.hpp"
+#include "assembly.h"
+#include "function_definition.hpp"
+#include "task_graph.h"
+
+// The whole source file. Functions are compiled callees first, so that what
+// is learnt about a function, such as the registers it clobbers, is known at
+// its call sites. Each one is compiled in a context of its own, as soon as
+// its callees are, so functions that do not call each other are compiled in
+// parallel. They are still written out in source order. Static functions are
+// internal to the file, and are left out unless a function that other files
+// can call ends up calling them.
+class TranslationUnit : public Node
+{
+private:
+    Node *declarations;
+
+    // Specialization limits: only functions up to maxSpecializedNodes are
+    // copied, and only if a constant parameter decides a branch or a loop
+    // bound, or the function is below smallFunctionNodes anyway
+    static const int maxSpecializedNodes = 200;
+    static const int smallFunctionNodes = 40;
+    static const int maxSpecializations = 4;
+
+    // Whether a branch or a loop bound in this subtree reads the variable
+    bool IsControlledBy(const Node *node, const std::string &variable) const {
+        std::set<std::string> reads;
+        Node *condition = node->GetBranchCondition();
+        if (condition != nullptr){
+            condition->GetReadVariables(reads);
+        }
+        std::string boundVariable, comparison;
+        Node *bound;
+        if (node->GetLoopBound(boundVariable, comparison, bound)){
+            bound->GetReadVariables(reads);
+        }
+        if (reads.count(variable)){
+            return true;
+        }
+        for (auto child : node->GetChildren()){
+            if (child != nullptr && IsControlledBy(child, variable)){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // A function is const if it only calls const functions, and pure if it
+    // only calls const and pure ones: variables only live in the function's
+    // own frame, which no caller can see. Functions start out const and are
+    // demoted until nothing changes, so recursive calls do not stand in the
+    // way. A const or pure attribute on a declaration is trusted as well.
+    static void InferFunctionEffects(Context &context, const std::map<std::string, const Node*> &definitions){
+        std::map<std::string, FunctionEffect> effects;
+        for (auto &definition : definitions){
+            effects[definition.first] = CONST_FUNCTION;
+        }
+        bool changed = true;
+        while (changed){
+            changed = false;
+            for (auto &definition : definitions){
+                std::set<std::string> callees;
+                definition.second->GetCalledFunctions(callees);
+                FunctionEffect effect = CONST_FUNCTION;
+                for (auto &callee : callees){
+                    FunctionEffect calleeEffect = context.getFunctionEffect(callee);
+                    if (effects.count(callee)){
+                        calleeEffect = std::min(calleeEffect, effects[callee]);
+                    }
+                    effect = std::max(effect, calleeEffect);
+                }
+                if (effect != effects[definition.first]){
+                    effects[definition.first] = effect;
+                    changed = true;
+                }
+            }
+        }
+        for (auto &effect : effects){
+            context.setFunctionEffect(effect.first, std::min(effect.second, context.getFunctionEffect(effect.first)));
+        }
+    }
+
+    // Interprocedural constant propagation. Calls to a defined function are
+    // grouped by the constant integer arguments they pass, counting only
+    // parameters the function never assigns. The groups with the most calls
+    // get a copy of the function with those parameters built in, where the
+    // copy is likely to fold enough to pay for its size. The original stays
+    // for callers in other files.
+    void Specialize(Context &context, const std::map<std::string, const Node*> &definitions,
+                    std::map<const Node*, std::vector<std::pair<std::string, std::map<int, int>>>> &specializations) const {
+        std::map<std::string, std::map<std::map<int, int>, int>> callCounts;
+        for (auto &definition : definitions){
+            std::vector<const Node *> calls;
+            definition.second->FindCalls(calls);
+            for (auto call : calls){
+                std::string function;
+                std::vector<Node *> arguments;
+                call->GetCall(function, arguments);
+                auto callee = definitions.find(function);
+                if (callee == definitions.end()){
+                    continue;
+                }
+                std::vector<const Node *> parameters;
+                callee->second->GetParameters(parameters);
+                if (parameters.size() != arguments.size()){
+                    continue;
+                }
+                std::set<std::string> writes;
+                callee->second->GetWrittenVariables(writes);
+                std::map<int, int> constants;
+                for (size_t i = 0; i < arguments.size(); i++){
+                    int value;
+                    if (parameters[i]->GetType()=="int" && !writes.count(parameters[i]->GetIdentifier())
+                        && !arguments[i]->HasSideEffects() && arguments[i]->GetConstantValue(context, value)){
+                        constants[i] = value;
+                    }
+                }
+                if (!constants.empty()){
+                    callCounts[function][constants]++;
+                }
+            }
+        }
+
+        for (auto &function : callCounts){
+            const Node *definition = definitions.at(function.first);
+            int size = definition->CountNodes();
+            if (size > maxSpecializedNodes || context.isColdFunction(function.first)){
+                continue;
+            }
+            std::vector<const Node *> parameters;
+            definition->GetParameters(parameters);
+            std::vector<std::pair<int, std::map<int, int>>> candidates;
+            for (auto &signature : function.second){
+                bool profitable = size <= smallFunctionNodes;
+                for (auto &constant : signature.first){
+                    profitable = profitable || IsControlledBy(definition, parameters[constant.first]->GetIdentifier());
+                }
+                if (profitable){
+                    candidates.push_back({-signature.second, signature.first});
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+            for (size_t i = 0; i < candidates.size() && i < maxSpecializations; i++){
+                std::string name = context.addSpecialization(function.first, candidates[i].second);
+                specializations[definition].push_back({name, candidates[i].second});
+            }
+        }
+    }
+
+    // Depth-first over the call graph, adding each function after the ones it
+    // calls. In a cycle of recursive calls, the function reached first comes
+    // last and the others call it without knowing about it.
+    void OrderFunction(std::string functionName, const std::map<std::string, const Node*> &definitions,
+                       std::set<std::string> &visited, std::vector<const Node*> &order) const {
+        auto definition = definitions.find(functionName);
+        if (definition == definitions.end() || !visited.insert(functionName).second){
+            return;
+        }
+        std::set<std::string> callees;
+        definition->second->GetCalledFunctions(callees);
+        for (auto &callee : callees){
+            OrderFunction(callee, definitions, visited, order);
+        }
+        order.push_back(definition->second);
+    }
+
+    // Functions of the call graph reachable from the given one
+    void MarkReachable(std::string functionName, const std::map<std::string, const Node*> &definitions, std::set<std::string> &reachable) const {
+        auto definition = definitions.find(functionName);
+        if (definition == definitions.end() || !reachable.insert(functionName).second){
+            return;
+        }
+        std::set<std::string> callees;
+        definition->second->GetCalledFunctions(callees);
+        for (auto &callee : callees){
+            MarkReachable(callee, definitions, reachable);
+        }
+    }
+
+    // The same over the calls in the compiled code
+    void MarkCalled(std::string functionName, const std::map<std::string, std::string> &functionCode, std::set<std::string> &called) const {
+        auto code = functionCode.find(functionName);
+        if (code == functionCode.end() || !called.insert(functionName).second){
+            return;
+        }
+        std::stringstream text(code->second);
+        for (auto &line : ParseAssembly(text)){
+            if (line.isCall() && !line.operands.empty()){
+                MarkCalled(line.operands[0], functionCode, called);
+            }
+        }
+    }
+
+    // A function, or a specialized copy of one, to compile. It sees the
+    // clobbers of the tasks before it in the callees-first order for the
+    // functions it calls, and of no other, as if they were compiled one
+    // after the other whatever the threads do.
+    struct FunctionTask{
+        const FunctionDefinition *definition;
+        std::string name;
+        std::map<int, int> constants;
+        std::vector<size_t> dependencies;
+    };
+
+    // Local labels L<n> renamed to L<n + offset>
+    static std::string ShiftLabels(const std::string &code, int offset){
+        std::string shifted;
+        size_t start = 0;
+        while (start < code.size()){
+            size_t end = start;
+            while (end < code.size() && (isalnum((unsigned char)code[end]) || code[end]=='_' || code[end]=='.' || code[end]=='$')){
+                end++;
+            }
+            if (end == start){
+                shifted += code[start++];
+                continue;
+            }
+            std::string token = code.substr(start, end - start);
+            if (offset != 0 && token.size() > 1 && token[0]=='L' && token.find_first_not_of("0123456789", 1)==std::string::npos){
+                token = "L" + std::to_string(std::stoll(token.substr(1)) + offset);
+            }
+            shifted += token;
+            start = end;
+        }
+        return shifted;
+    }
+
+public:
+    TranslationUnit(Node *declarations_) : declarations(declarations_){}
+    ~TranslationUnit(){
+        delete declarations;
+    }
+
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const {
+        std::map<std::string, const Node*> definitions;
+        for (auto declaration : declarations->GetChildren()){
+            if (declaration == nullptr){
+                continue;
+            }
+            if (declaration->IsFunctionDefinition()){
+                definitions[declaration->GetIdentifier()] = declaration;
+                if (declaration->GetStorageClass()=="static"){
+                    context.setInternalFunction(declaration->GetIdentifier());
+                }
+            }
+            else{
+                declaration->EmitRISC(stream, context, destReg);
+            }
+        }
+
+        // Internal functions that no external function calls, directly or
+        // not, are never compiled
+        std::set<std::string> reachable;
+        for (auto &definition : definitions){
+            if (!context.isInternalFunction(definition.first)){
+                MarkReachable(definition.first, definitions, reachable);
+            }
+        }
+        for (auto definition = definitions.begin(); definition != definitions.end();){
+            definition = reachable.count(definition->first) ? std::next(definition) : definitions.erase(definition);
+        }
+
+        // Every definition is declared before any function is compiled, so
+        // that no call depends on which of them were compiled first
+        for (auto &definition : definitions){
+            context.setFunctionType(definition.first, static_cast<const FunctionDefinition*>(definition.second)->GetReturnType());
+        }
+        InferFunctionEffects(context, definitions);
+        std::map<const Node*, std::vector<std::pair<std::string, std::map<int, int>>>> specializations;
+        Specialize(context, definitions, specializations);
+
+        std::set<std::string> visited;
+        std::vector<const Node*> order;
+        for (auto declaration : declarations->GetChildren()){
+            if (declaration != nullptr && declaration->IsFunctionDefinition()){
+                OrderFunction(declaration->GetIdentifier(), definitions, visited, order);
+            }
+        }
+        std::vector<FunctionTask> tasks;
+        std::map<std::string, std::vector<size_t>> functionTasks; // Function name binding to the tasks for it and its copies
+        for (auto function : order){
+            auto definition = static_cast<const FunctionDefinition*>(function);
+            functionTasks[function->GetIdentifier()].push_back(tasks.size());
+            tasks.push_back({definition, function->GetIdentifier(), {}, {}});
+            for (auto &specialization : specializations[function]){
+                functionTasks[function->GetIdentifier()].push_back(tasks.size());
+                tasks.push_back({definition, specialization.first, specialization.second, {}});
+            }
+        }
+        for (size_t i = 0; i < tasks.size(); i++){
+            std::set<std::string> callees;
+            tasks[i].definition->GetCalledFunctions(callees);
+            for (auto &callee : callees){
+                for (size_t task : functionTasks[callee]){
+                    if (task < i){
+                        tasks[i].dependencies.push_back(task);
+                    }
+                }
+            }
+        }
+
+        std::vector<Context> contexts(tasks.size(), context.functionContext());
+        std::vector<std::string> code(tasks.size());
+        std::vector<std::vector<size_t>> dependencies;
+        for (auto &task : tasks){
+            dependencies.push_back(task.dependencies);
+        }
+        RunTaskGraph(dependencies, context.getCodegenThreads(), [&](size_t i){
+            FunctionTask &task = tasks[i];
+            for (size_t dependency : task.dependencies){
+                std::set<std::string> clobbers;
+                if (contexts[dependency].getFunctionClobbers(tasks[dependency].name, clobbers)){
+                    contexts[i].setFunctionClobbers(tasks[dependency].name, clobbers);
+                }
+            }
+            std::stringstream stream;
+            if (task.name == task.definition->GetIdentifier()){
+                task.definition->EmitRISC(stream, contexts[i], destReg);
+            }
+            else{
+                task.definition->EmitSpecialization(stream, contexts[i], destReg, task.name, task.constants);
+            }
+            code[i] = stream.str();
+        });
+
+        // Labels are numbered on in the same order, so the output does not
+        // depend on the number of threads
+        std::map<std::string, std::string> functionCode;
+        for (size_t i = 0; i < tasks.size(); i++){
+            functionCode[tasks[i].name] = ShiftLabels(code[i], context.getBranchLabels());
+            context.mergeFunction(contexts[i]);
+        }
+
+        // Calls can still disappear while compiling, e.g. in branches that
+        // fold away, so internal functions and specialized copies are only
+        // written out if the code kept calls them
+        std::set<std::string> called;
+        for (auto &function : functionCode){
+            if (definitions.count(function.first) && !context.isInternalFunction(function.first)){
+                MarkCalled(function.first, functionCode, called);
+            }
+        }
+        for (auto declaration : declarations->GetChildren()){
+            if (declaration == nullptr || !declaration->IsFunctionDefinition() || !definitions.count(declaration->GetIdentifier())){
+                continue;
+            }
+            std::string functionName = declaration->GetIdentifier();
+            if (called.count(functionName)){
+                stream << functionCode[functionName];
+            }
+            for (auto &specialization : specializations[declaration]){
+                if (called.count(specialization.first)){
+                    stream << functionCode[specialization.first];
+                }
+            }
+        }
+    }
+    // Compile one top-level declaration of a file streamed from the parser,
+    // knowing only the declarations before it. Functions are compiled in
+    // source order: calls to functions defined later assume they clobber
+    // every caller-saved register and have side effects, nothing is
+    // specialized, and static functions are kept whether they are called
+    // or not.
+    static void EmitStreamed(std::ostream &stream, Context &context, const Node *declaration, int destReg){
+        if (declaration->IsFunctionDefinition()){
+            std::string functionName = declaration->GetIdentifier();
+            if (declaration->GetStorageClass()=="static"){
+                context.setInternalFunction(functionName);
+            }
+            context.setFunctionType(functionName, static_cast<const FunctionDefinition*>(declaration)->GetReturnType());
+            InferFunctionEffects(context, {{functionName, declaration}});
+        }
+        declaration->EmitRISC(stream, context, destReg);
+    }
+    void Print(std::ostream &stream) const {
+        declarations->Print(stream);
+    }
+    std::vector<Node *> GetChildren() const {
+        return {declarations};
+    }
+};
+
+#endif
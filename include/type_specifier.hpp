@@ -20,6 +20,31 @@ public:
     }
 };
 
+// `static`, `extern` and the other storage classes in front of a type
+class StorageClassSpecifier : public Node
+{
+private:
+    std::string storageClass_;
+    Node *type_;
+
+public:
+    StorageClassSpecifier(std::string storageClass, Node *type) : storageClass_(storageClass), type_(type){};
+    ~StorageClassSpecifier(){
+        delete type_;
+    };
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const override {};
+    void Print(std::ostream &stream) const {
+        stream << storageClass_ << " ";
+        type_->Print(stream);
+    }
+    std::string GetType() const{
+        return type_->GetType();
+    }
+    std::string GetStorageClass() const{
+        return storageClass_;
+    }
+};
+
 class SizeOfVariable : public Node
 {
 private:
@@ -26,6 +26,23 @@ public:
             declarator->EmitRISC(stream, context, destReg);
         }
     }
+    void EmitDeclaration(std::ostream &stream, Context &context, std::string type) const {
+        std::string variableName = declarator->GetIdentifier();
+        int arrayLength;
+        if (declarator->GetArrayLength(context, arrayLength)){
+            context.bindArray(variableName, type, arrayLength);
+        }
+        else if (initialiser!=nullptr){
+            int initialiserRegister = context.findFreeRegister();
+            initialiser->EmitRISC(stream, context, initialiserRegister);
+            int variableAddress = context.bindVariable(variableName, type);
+            EmitStore(stream, context, type, initialiserRegister, variableAddress);
+            context.freeRegister(initialiserRegister);
+        }
+        else{
+            context.bindVariable(variableName, type);
+        }
+    }
     void Print(std::ostream &stream) const {
         if (initialiser!=nullptr){
             declarator->Print(stream);
@@ -39,6 +56,15 @@ public:
         stream << ";" << std::endl;
 
     }
+    std::vector<Node *> GetChildren() const {
+        return {declarator, initialiser};
+    }
+    void GetWrittenVariables(std::set<std::string> &variables) const {
+        variables.insert(declarator->GetIdentifier());
+        if (initialiser!=nullptr){
+            initialiser->GetWrittenVariables(variables);
+        }
+    }
 };
 
 class VariableAssignExpression : public Node
@@ -55,40 +81,123 @@ public:
     }
 
     void EmitRISC(std::ostream &stream, Context &context, int destReg) const{
+        std::string array;
+        Node *index;
+        if (unary_expression->GetArrayAccess(array, index)){
+            assignement_expression->EmitRISC(stream, context, destReg);
+            unary_expression->EmitElementStore(stream, context, destReg);
+            return;
+        }
 
         unary_expression->EmitRISC(stream, context, destReg);
         assignement_expression->EmitRISC(stream, context, destReg);
 
         std::string variableName = unary_expression->GetIdentifier();
 
-        std::string variableType;
-        int currentStackLocation;
         if (context.variableLocation(variableName)==-1){
-            variableType="double";
-            currentStackLocation=context.bindVariable(variableName, variableType);
+            context.bindVariable(variableName, "double");
         }
-        else{
-            currentStackLocation=context.variableLocation(variableName);
-            variableType = context.getVariableType(variableName);
+        EmitVariableStore(stream, context, variableName, destReg);
+    }
+    void Print(std::ostream &stream) const {
+        unary_expression->Print(stream);
+        stream<<" = ";
+        assignement_expression->Print(stream);
+    }
+    std::vector<Node *> GetChildren() const {
+        return {unary_expression, assignement_expression};
+    }
+    void GetWrittenVariables(std::set<std::string> &variables) const {
+        variables.insert(unary_expression->GetIdentifier());
+        assignement_expression->GetWrittenVariables(variables);
+    }
+    // The assigned variable is a destination, not a read, but the index of an
+    // assigned array element is
+    void GetReadVariables(std::set<std::string> &variables) const {
+        if (!unary_expression->IsVariable()){
+            unary_expression->GetReadVariables(variables);
         }
-
-        if (variableType=="float"){
-            stream<<"fsw f"<<context.getRegisterName(destReg)<<", " <<currentStackLocation<<"(sp)"<<std::endl;
+        assignement_expression->GetReadVariables(variables);
+    }
+    bool HasSideEffects() const {
+        return true;
+    }
+    bool IsRepeatable(Context &context, bool &readsMemory) const {
+        return false;
+    }
+    bool GetAssignedConstant(Context &context, std::string &variable, int &value) const {
+        if (!unary_expression->IsVariable()){
+            return false;
         }
-        else if(variableType=="double"){
-            stream<<"fsd f"<<context.getRegisterName(destReg)<<", " <<currentStackLocation<<"(sp)"<<std::endl;
+        variable = unary_expression->GetIdentifier();
+        return assignement_expression->GetConstantValue(context, value);
+    }
+    bool GetIncrement(Context &context, std::string &variable, int &step) const {
+        if (!unary_expression->IsVariable()){
+            return false;
         }
-        else if(variableType=="char"){
-            stream<<"sb "<<context.getRegisterName(destReg)<<", "<<currentStackLocation<<"(sp)"<<std::endl;
+        variable = unary_expression->GetIdentifier();
+        return assignement_expression->GetOffset(context, variable, step);
+    }
+};
+
+// Prefix and postfix ++ and --
+class IncrementExpression : public Node
+{
+private:
+    Node *variable;
+    int step;
+    bool prefix;
+public:
+    IncrementExpression(Node* variable_, int step_, bool prefix_) : variable(variable_), step(step_), prefix(prefix_){}
+
+    virtual ~IncrementExpression(){
+        delete variable;
+    }
+
+    void EmitRISC(std::ostream &stream, Context &context, int destReg) const{
+        std::string variableName = variable->GetIdentifier();
+
+        int updatedRegister = prefix ? destReg : context.findFreeRegister();
+        variable->EmitRISC(stream, context, destReg);
+        stream<<"addi "<<context.getRegisterName(updatedRegister)<<", "<<context.getRegisterName(destReg)<<", "<<step<<std::endl;
+        if (!variable->EmitElementStore(stream, context, updatedRegister)){
+            EmitVariableStore(stream, context, variableName, updatedRegister);
         }
-        else{
-            stream<<"sw "<<context.getRegisterName(destReg)<<", "<<currentStackLocation<<"(sp)"<<std::endl;
+        if (!prefix){
+            context.freeRegister(updatedRegister);
         }
     }
     void Print(std::ostream &stream) const {
-        unary_expression->Print(stream);
-        stream<<" = ";
-        assignement_expression->Print(stream);
+        std::string symbol = step > 0 ? "++" : "--";
+        if (prefix){
+            stream<<symbol;
+        }
+        variable->Print(stream);
+        if (!prefix){
+            stream<<symbol;
+        }
+    }
+    std::vector<Node *> GetChildren() const {
+        return {variable};
+    }
+    void GetWrittenVariables(std::set<std::string> &variables) const {
+        variables.insert(variable->GetIdentifier());
+    }
+    bool HasSideEffects() const {
+        return true;
+    }
+    // Postfix forms keep the old value while storing the new one
+    int GetRegisterNeed(Context &context) const {
+        return prefix ? 1 : 2;
+    }
+    bool GetIncrement(Context &context, std::string &variableName, int &step_) const {
+        if (!variable->IsVariable()){
+            return false;
+        }
+        variableName = variable->GetIdentifier();
+        step_ = step;
+        return true;
     }
 };
 
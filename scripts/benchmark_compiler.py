@@ -0,0 +1,328 @@
+#!/usr/bin/env python3
+
+"""
+Measures how fast the compiler itself is. The script generates synthetic C
+sources at several sizes, compiles each one and reports, for every phase the
+compiler announces on stdout (parsing, printing the AST, code generation), the
+lines compiled per second and the peak resident memory at the end of the
+phase.
+
+Comparing the times at the different sizes gives the growth exponent of each
+workload: about 1 when the compiler is linear in the size of the source, 2
+when it is quadratic.
+
+Usage: benchmark_compiler.py [-h] [--compiler COMPILER] [--sizes SIZES]
+                             [--workloads WORKLOADS] [--timeout TIMEOUT]
+                             [--output OUTPUT]
+
+Example usage: make benchmark
+
+This builds bin/c_compiler_release, without sanitizers or coverage, and runs
+this script on it. The results also go to bin/compiler_benchmark.json, with
+the commit they were measured at.
+"""
+
+
+import os
+import sys
+import json
+import math
+import time
+import argparse
+import subprocess
+import tempfile
+import threading
+from dataclasses import dataclass, field, asdict
+from pathlib import Path
+from typing import Callable, Dict, List, Optional
+
+
+SCRIPT_LOCATION = Path(__file__).resolve().parent
+PROJECT_LOCATION = SCRIPT_LOCATION.joinpath("..").resolve()
+COMPILER_FILE = PROJECT_LOCATION.joinpath("bin/c_compiler_release").resolve()
+OUTPUT_FILE = PROJECT_LOCATION.joinpath("bin/compiler_benchmark.json").resolve()
+
+DEFAULT_TIMEOUT_SECONDS = 60
+DEFAULT_SIZES = "0.25,0.5,1"
+
+# Lines the compiler prints at the start and end of each phase
+PHASES = [
+    ("parse", "Parsing", "AST parsing complete"),
+    ("print", "Printing parsed AST", "Printed parsed AST"),
+    ("codegen", "Compiling parsed AST", "Compiled to"),
+]
+
+
+def many_functions(scale: float) -> str:
+    """Thousands of small functions, each calling the one before"""
+    count = max(1, int(4000 * scale))
+    lines = ["int f0(int x)", "{", "    return x + 1;", "}"]
+    for i in range(1, count):
+        lines += [
+            f"int f{i}(int x)",
+            "{",
+            f"    int y = x * {i % 7 + 1};",
+            f"    return f{i - 1}(y) - {i};",
+            "}",
+        ]
+    return "\n".join(lines) + "\n"
+
+
+def long_function(scale: float) -> str:
+    """One function with ten thousand lines of statements"""
+    count = max(1, int(10000 * scale))
+    lines = ["int f(int a, int b)", "{", "    int x = 0;", "    int y = 1;"]
+    for i in range(count):
+        if i % 4 == 3:
+            lines.append(f"    if (x > {i}) y = y + a; else x = x - b;")
+        else:
+            lines.append(f"    x = x + y * {i % 13 + 1} - a;")
+    lines += ["    return x + y;", "}"]
+    return "\n".join(lines) + "\n"
+
+
+def deep_expression(scale: float) -> str:
+    """An expression nested a thousand levels deep"""
+    depth = max(1, int(1000 * scale))
+    # Nesting on the left keeps the register pressure flat, so only the depth
+    # of the tree grows. Each level goes on its own line, to count as one.
+    lines = ["int f(int x)", "{", "    return " + "(" * depth + "x"]
+    for i in range(depth):
+        lines.append(f"        {'+-*'[i % 3]} {i % 9 + 1})")
+    lines += ["    ;", "}"]
+    return "\n".join(lines) + "\n"
+
+
+def big_switch(scale: float) -> str:
+    """A switch statement with thousands of cases"""
+    count = max(1, int(2000 * scale))
+    lines = ["int f(int x)", "{", "    int y = 0;", "    switch (x)", "    {"]
+    for i in range(count):
+        lines += [f"    case {i * 3}:", f"        y = {i} * x;", "        break;"]
+    lines += ["    default:", "        y = -1;", "    }", "    return y;", "}"]
+    return "\n".join(lines) + "\n"
+
+
+WORKLOADS: Dict[str, Callable[[float], str]] = {
+    "many_functions": many_functions,
+    "long_function": long_function,
+    "deep_expression": deep_expression,
+    "big_switch": big_switch,
+}
+
+
+@dataclass
+class Phase:
+    """One phase of one compilation"""
+    seconds: float
+    lines_per_second: float
+    peak_rss_kb: int
+
+
+@dataclass
+class Run:
+    """One compilation of a generated source"""
+    workload: str
+    scale: float
+    lines: int
+    seconds: float = 0
+    cpu_seconds: float = 0
+    peak_rss_kb: int = 0
+    phases: Dict[str, Phase] = field(default_factory=dict)
+    error: Optional[str] = None
+
+
+def peak_rss(pid: int) -> int:
+    """High water mark of the resident memory of a running process, in kB"""
+    try:
+        with open(f"/proc/{pid}/status") as status:
+            for line in status:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1])
+    except OSError:
+        pass
+    return 0
+
+
+def compile_source(compiler: Path, workload: str, scale: float, folder: Path, timeout: float) -> Run:
+    """
+    Compiles the generated source, timing each phase from the moment the
+    compiler prints that it starts to the moment it prints that it finished.
+    The peak memory is sampled at the same moments, as the resource usage
+    of the child also counts the memory of this script it was forked from.
+    """
+    source = WORKLOADS[workload](scale)
+    source_path = folder.joinpath(f"{workload}.c")
+    source_path.write_text(source)
+    run = Run(workload=workload, scale=scale, lines=source.count("\n"))
+
+    start = time.perf_counter()
+    process = subprocess.Popen(
+        [compiler, "-S", source_path, "-o", folder.joinpath(f"{workload}.s")],
+        stdout=subprocess.PIPE,
+        stderr=subprocess.DEVNULL,
+        text=True,
+    )
+    timer = threading.Timer(timeout, process.kill)
+    timer.start()
+    started: Dict[str, float] = {}
+    for line in process.stdout:
+        now = time.perf_counter()
+        run.peak_rss_kb = max(run.peak_rss_kb, peak_rss(process.pid))
+        for name, begin, end in PHASES:
+            if line.startswith(begin):
+                started[name] = now
+            elif line.startswith(end) and name in started:
+                seconds = now - started[name]
+                run.phases[name] = Phase(
+                    seconds=seconds,
+                    lines_per_second=run.lines / seconds if seconds > 0 else math.inf,
+                    peak_rss_kb=run.peak_rss_kb,
+                )
+
+    # wait4 rather than wait, for the resource usage of this child alone
+    _, status, usage = os.wait4(process.pid, 0)
+    process.returncode = os.waitstatus_to_exitcode(status)
+    run.seconds = time.perf_counter() - start
+    run.cpu_seconds = usage.ru_utime + usage.ru_stime
+    if not timer.is_alive():
+        run.error = f"timed out after {timeout:g}s"
+    elif process.returncode != 0:
+        run.error = f"exit status {process.returncode}"
+    elif "codegen" not in run.phases:
+        run.error = "did not finish code generation"
+    timer.cancel()
+    return run
+
+
+def growth_exponent(runs: List[Run]) -> Optional[float]:
+    """k such that time grows as lines^k, between the smallest and largest runs that finished"""
+    finished = [run for run in runs if run.error is None]
+    if len(finished) < 2:
+        return None
+    smaller, larger = finished[0], finished[-1]
+    if larger.lines <= smaller.lines:
+        return None
+    if smaller.cpu_seconds <= 0 or larger.cpu_seconds <= 0:
+        return None
+    return math.log(larger.cpu_seconds / smaller.cpu_seconds) / math.log(larger.lines / smaller.lines)
+
+
+def git_commit() -> Optional[str]:
+    try:
+        return subprocess.run(
+            ["git", "rev-parse", "HEAD"],
+            cwd=PROJECT_LOCATION,
+            capture_output=True,
+            text=True,
+            check=True,
+        ).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def megabytes(kb: int) -> str:
+    # No sample when the compiler exited before its output was read
+    return f"{kb / 1024:.1f}" if kb > 0 else "-"
+
+
+def print_report(runs: List[Run], exponents: Dict[str, Optional[float]]):
+    header = f"{'workload':<16} {'scale':>6} {'lines':>7} {'total s':>8} {'cpu s':>8} {'peak MB':>8}"
+    for name, _, _ in PHASES:
+        header += f" {name + ' lines/s':>18} {name + ' MB':>11}"
+    print(header)
+    for run in runs:
+        row = f"{run.workload:<16} {run.scale:>6g} {run.lines:>7}"
+        if run.error:
+            print(f"{row} failed: {run.error}")
+            continue
+        row += f" {run.seconds:>8.3f} {run.cpu_seconds:>8.3f} {megabytes(run.peak_rss_kb):>8}"
+        for name, _, _ in PHASES:
+            phase = run.phases.get(name)
+            if phase is None:
+                row += f" {'-':>18} {'-':>11}"
+            else:
+                row += f" {phase.lines_per_second:>18.0f} {megabytes(phase.peak_rss_kb):>11}"
+        print(row)
+    print()
+    for workload, exponent in exponents.items():
+        growth = "unknown" if exponent is None else f"lines^{exponent:.2f}"
+        print(f"{workload:<16} time grows as {growth}")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--compiler",
+        type=Path,
+        default=COMPILER_FILE,
+        help="Compiler to measure. Defaults to bin/c_compiler_release."
+    )
+    parser.add_argument(
+        "--sizes",
+        default=DEFAULT_SIZES,
+        help="Comma separated scales of the generated sources, relative to "
+             f"the full size. Defaults to {DEFAULT_SIZES}."
+    )
+    parser.add_argument(
+        "--workloads",
+        default=",".join(WORKLOADS),
+        help="Comma separated workloads to run. Defaults to all of them: "
+             f"{', '.join(WORKLOADS)}."
+    )
+    parser.add_argument(
+        "--timeout",
+        type=float,
+        default=DEFAULT_TIMEOUT_SECONDS,
+        help="Seconds a compilation may take before it counts as failed. "
+             f"Defaults to {DEFAULT_TIMEOUT_SECONDS}."
+    )
+    parser.add_argument(
+        "--output",
+        type=Path,
+        default=OUTPUT_FILE,
+        help="Where to write the results as JSON. Defaults to "
+             "bin/compiler_benchmark.json."
+    )
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    if not args.compiler.exists():
+        print(f"No compiler at {args.compiler}, run make release first")
+        sys.exit(1)
+    scales = sorted(float(scale) for scale in args.sizes.split(","))
+    workloads = args.workloads.split(",")
+    for workload in workloads:
+        if workload not in WORKLOADS:
+            print(f"Unknown workload {workload}")
+            sys.exit(1)
+
+    runs: List[Run] = []
+    exponents: Dict[str, Optional[float]] = {}
+    with tempfile.TemporaryDirectory() as folder:
+        for workload in workloads:
+            workload_runs = [
+                compile_source(args.compiler.resolve(), workload, scale, Path(folder), args.timeout)
+                for scale in scales
+            ]
+            runs += workload_runs
+            exponents[workload] = growth_exponent(workload_runs)
+
+    print_report(runs, exponents)
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    with open(args.output, "w") as output:
+        json.dump({
+            "commit": git_commit(),
+            "compiler": str(args.compiler),
+            "runs": [asdict(run) for run in runs],
+            "growth_exponents": exponents,
+        }, output, indent=2)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(1)
@@ -7,13 +7,25 @@ Makefile, run the tests and store the outputs in bin/output.
 This script will also generate a JUnit XML file, which can be used to integrate
 with CI/CD pipelines.
 
-Usage: test.py [-h] [-m] [-s] [--version] [--no_clean] [--coverage] [dir]
+Usage: test.py [-h] [-m] [-s] [--version] [--no_clean] [--coverage] [--batch]
+               [--benchmark] [--update_baseline] [--threshold THRESHOLD] [dir]
 
 Example usage: scripts/test.py compiler_tests/_example
 
 This will print out a progress bar and only run the example tests.
 The output would be placed into bin/output/_example/example/.
 
+With --benchmark, each passing test is also measured: the number of
+instructions spike runs in the test's own code, and the size of its .text, for
+this compiler and for gcc -O0 and -O2. The ratios go to bin/benchmark_report.txt
+and the run fails if this compiler's numbers are worse than the stored baseline
+by more than the threshold.
+
+With --batch, every test is compiled by a single run of the compiler, from a
+manifest in bin/output/manifest.txt, before they are assembled and run. Tests
+the batch leaves without assembly, e.g. after a crash, are compiled on their
+own as usual.
+
 For more information, run scripts/test.py --help
 """
 
@@ -23,15 +35,18 @@ __author__ = "William Huynh (@saturn691), Filip Wojcicki, James Nock"
 
 
 import os
+import re
 import sys
+import json
+import math
 import argparse
 import shutil
 import subprocess
-from dataclasses import dataclass
+from dataclasses import dataclass, asdict
 from xml.sax.saxutils import escape as xmlescape, quoteattr as xmlquoteattr
 from pathlib import Path
 from concurrent.futures import ThreadPoolExecutor, as_completed
-from typing import List, Optional
+from typing import Dict, List, Optional
 from http.server import HTTPServer, SimpleHTTPRequestHandler
 
 
@@ -51,11 +66,25 @@ J_UNIT_OUTPUT_FILE = PROJECT_LOCATION.joinpath("bin/junit_results.xml").resolve(
 COMPILER_TEST_FOLDER = PROJECT_LOCATION.joinpath("compiler_tests").resolve()
 COMPILER_FILE = PROJECT_LOCATION.joinpath("bin/c_compiler").resolve()
 COVERAGE_FOLDER = PROJECT_LOCATION.joinpath("coverage").resolve()
+BENCHMARK_REPORT_FILE = PROJECT_LOCATION.joinpath("bin/benchmark_report.txt").resolve()
+BENCHMARK_BASELINE_FILE = SCRIPT_LOCATION.joinpath("benchmark_baseline.json").resolve()
 
 BUILD_TIMEOUT_SECONDS = 60
 RUN_TIMEOUT_SECONDS = 15
 TIMEOUT_RETURNCODE = 124
 
+# Compilers each test is measured with. Only the first is held to the baseline.
+OURS = "c_compiler"
+REFERENCE_LEVELS = ["-O0", "-O2"]
+# Allowed growth over the baseline before a benchmark counts as a regression
+DEFAULT_REGRESSION_THRESHOLD = 0.02
+
+@dataclass
+class Measurement:
+    """Cost of the code compiled from one test file"""
+    instructions: int   # Dynamic count, from the spike log
+    text_size: int      # Bytes in the object's .text sections
+
 @dataclass
 class Result:
     """Class for keeping track of each test case result"""
@@ -64,6 +93,8 @@ class Result:
     return_code: int
     timeout: bool
     error_log: Optional[str]
+    # Compiler name binding to its measurement, with --benchmark
+    benchmark: Optional[Dict[str, Measurement]] = None
 
     def to_xml(self) -> str:
         if self.passed:
@@ -177,31 +208,63 @@ class ProgressBar:
             self.failed += 1
         self.update()
 
-def run_test(driver: Path) -> Result:
+def test_paths(driver: Path) -> tuple[Path, Path]:
     """
-    Run an instance of a test case.
-
-    Parameters:
-    - driver: driver path.
-
-    Returns Result object
+    Returns the source file a driver tests, and the path its logs and outputs
+    are stored at, without the suffix, e.g. .../bin/output/_example/example/example
     """
-
     # Replaces example_driver.c -> example.c
     new_name = driver.stem.replace('_driver', '') + '.c'
     to_assemble = driver.parent.joinpath(new_name).resolve()
-    test_name = to_assemble.relative_to(PROJECT_LOCATION)
 
     # Determine the relative path to the file wrt. COMPILER_TEST_FOLDER.
     relative_path = to_assemble.relative_to(COMPILER_TEST_FOLDER)
 
-    # Construct the path where logs would be stored, without the suffix
-    # e.g. .../bin/output/_example/example/example
     log_path = Path(OUTPUT_FOLDER).joinpath(relative_path.parent, to_assemble.stem, to_assemble.stem)
+    return to_assemble, log_path
 
-    # Recreate the directory
-    shutil.rmtree(log_path.parent, ignore_errors=True)
-    log_path.parent.mkdir(parents=True, exist_ok=True)
+def compile_batch(drivers: List[Path]):
+    """
+    Compile the tests of all the drivers with one run of the compiler, which
+    compiles the files of a manifest on a pool of threads.
+    """
+    manifest_path = Path(OUTPUT_FOLDER).joinpath("manifest.txt")
+    with open(manifest_path, "w") as manifest:
+        for driver in drivers:
+            to_assemble, log_path = test_paths(driver)
+            shutil.rmtree(log_path.parent, ignore_errors=True)
+            log_path.parent.mkdir(parents=True, exist_ok=True)
+            manifest.write(f"{to_assemble} {log_path}.s\n")
+
+    custom_env = os.environ.copy()
+    custom_env["ASAN_OPTIONS"] = "exitcode=0"
+    run_subprocess(
+        cmd=[COMPILER_FILE, "-fmanifest", manifest_path],
+        timeout=RUN_TIMEOUT_SECONDS * max(1, len(drivers)),
+        env=custom_env,
+        log_path=Path(OUTPUT_FOLDER).joinpath("batch.compiler"),
+    )
+
+def run_test(driver: Path, benchmark: bool = False, batched: bool = False) -> Result:
+    """
+    Run an instance of a test case.
+
+    Parameters:
+    - driver: driver path.
+    - benchmark: also measure the test against gcc if it passes.
+    - batched: the test was already compiled by compile_batch.
+
+    Returns Result object
+    """
+
+    to_assemble, log_path = test_paths(driver)
+    test_name = to_assemble.relative_to(PROJECT_LOCATION)
+
+    # Recreate the directory, unless the batch compiled the test already
+    compiled = batched and Path(f"{log_path}.s").exists()
+    if not compiled:
+        shutil.rmtree(log_path.parent, ignore_errors=True)
+        log_path.parent.mkdir(parents=True, exist_ok=True)
 
     # Modifying environment to combat errors on memory leak
     custom_env = os.environ.copy()
@@ -212,12 +275,16 @@ def run_test(driver: Path) -> Result:
     compiler_log_file_str=f"{relevant_files('compiler')} \n\t {log_path}.s \n\t {log_path}.s.printed"
 
     # Compile
-    return_code, _, timed_out = run_subprocess(
-        cmd=[COMPILER_FILE, "-S", to_assemble, "-o", f"{log_path}.s"],
-        timeout=RUN_TIMEOUT_SECONDS,
-        env=custom_env,
-        log_path=f"{log_path}.compiler",
-    )
+    return_code, timed_out = 0, False
+    if compiled:
+        compiler_log_file_str = f"{OUTPUT_FOLDER}/batch.compiler.stderr.log \n\t {log_path}.s \n\t {log_path}.s.printed"
+    else:
+        return_code, _, timed_out = run_subprocess(
+            cmd=[COMPILER_FILE, "-S", to_assemble, "-o", f"{log_path}.s"],
+            timeout=RUN_TIMEOUT_SECONDS,
+            env=custom_env,
+            log_path=f"{log_path}.compiler",
+        )
     if return_code != 0:
         msg = f"\t> Failed to compile testcase: \n\t {compiler_log_file_str}"
         return Result(test_case_name=test_name, return_code=return_code, passed=False, timeout=timed_out, error_log=msg)
@@ -271,7 +338,187 @@ def run_test(driver: Path) -> Result:
         msg = f"\t> Failed to simulate: \n\t {compiler_log_file_str} \n\t {relevant_files('simulation')}"
         return Result(test_case_name=test_name, return_code=return_code, passed=False, timeout=timed_out, error_log=msg)
 
-    return Result(test_case_name=test_name, return_code=return_code, passed=True, timeout=False, error_log="")
+    measurements = None
+    if benchmark:
+        measurements = benchmark_test(driver, to_assemble, log_path)
+        if measurements is None:
+            msg = f"\t> Failed to benchmark: \n\t {log_path}.bench.*.log"
+            return Result(test_case_name=test_name, return_code=1, passed=False, timeout=False, error_log=msg)
+
+    return Result(test_case_name=test_name, return_code=return_code, passed=True, timeout=False, error_log="",
+                  benchmark=measurements)
+
+def text_ranges(map_file: str, object_file: str) -> List[tuple]:
+    """
+    Address ranges the linker gave the .text sections of one object, read
+    from its map file. Long section names put the address on the next line.
+    """
+    ranges = []
+    with open(map_file) as f:
+        text = f.read()
+    pattern = re.compile(r"^ (\.text[\w.]*)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+)$", re.MULTILINE)
+    for match in pattern.finditer(text):
+        start, size = int(match.group(2), 16), int(match.group(3), 16)
+        if size > 0 and Path(match.group(4)).resolve() == Path(object_file).resolve():
+            ranges.append((start, start + size))
+    return ranges
+
+def count_instructions(trace_file: str, ranges: List[tuple]) -> int:
+    """
+    Instructions in a spike -l trace whose address is in one of the ranges.
+    Code from pk, the C library and the driver is left out.
+    """
+    count = 0
+    pattern = re.compile(r"core\s+\d+: 0x([0-9a-f]+) \(")
+    with open(trace_file) as f:
+        for line in f:
+            match = pattern.match(line)
+            if match is None:
+                continue
+            pc = int(match.group(1), 16) & 0xffffffff
+            if any(start <= pc < end for start, end in ranges):
+                count += 1
+    return count
+
+def text_size(object_file: str, log_path: str) -> Optional[int]:
+    """
+    Bytes in the .text sections of an object, from size -A.
+    """
+    return_code, _, _ = run_subprocess(
+        cmd=["riscv64-unknown-elf-size", "-A", object_file],
+        timeout=RUN_TIMEOUT_SECONDS,
+        log_path=log_path,
+    )
+    if return_code != 0:
+        return None
+    size = 0
+    with open(f"{log_path}.stdout.log") as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 2 and fields[0].startswith(".text") and fields[1].isdigit():
+                size += int(fields[1])
+    return size
+
+def measure(driver: Path, object_file: str, prefix: str) -> Optional[Measurement]:
+    """
+    Link an object with its driver and run it under spike with the
+    instruction log on, counting what runs in the object's own code.
+    """
+    return_code, _, _ = run_subprocess(
+        cmd=[
+                "riscv64-unknown-elf-gcc", "-march=rv32imfd", "-mabi=ilp32d", "-static",
+                f"-Wl,-Map={prefix}.map", "-o", prefix, object_file, str(driver)
+            ],
+        timeout=RUN_TIMEOUT_SECONDS,
+        log_path=f"{prefix}.linker",
+    )
+    if return_code != 0:
+        return None
+    return_code, _, _ = run_subprocess(
+        cmd=["spike", "-l", "pk", prefix],
+        timeout=RUN_TIMEOUT_SECONDS,
+        log_path=f"{prefix}.simulation",
+    )
+    size = text_size(object_file, f"{prefix}.size")
+    if return_code != 0 or size is None:
+        return None
+    ranges = text_ranges(f"{prefix}.map", object_file)
+    instructions = count_instructions(f"{prefix}.simulation.stderr.log", ranges)
+    return Measurement(instructions=instructions, text_size=size)
+
+def benchmark_test(driver: Path, to_assemble: Path, log_path: Path) -> Optional[Dict[str, Measurement]]:
+    """
+    Measure a test compiled by our compiler, whose object is already built,
+    and by gcc at each reference optimisation level.
+    """
+    measurements = {OURS: measure(driver, f"{log_path}.o", f"{log_path}.bench.ours")}
+    for level in REFERENCE_LEVELS:
+        object_file = f"{log_path}.gcc{level}.o"
+        return_code, _, _ = run_subprocess(
+            cmd=[
+                    "riscv64-unknown-elf-gcc", "-std=c90", "-pedantic", "-ansi", level, "-march=rv32imfd", "-mabi=ilp32d",
+                    "-o", object_file, "-c", to_assemble
+                ],
+            timeout=RUN_TIMEOUT_SECONDS,
+            log_path=f"{log_path}.bench.gcc{level}.compiler",
+        )
+        measurements[f"gcc {level}"] = None if return_code != 0 else measure(driver, object_file, f"{log_path}.bench.gcc{level}")
+    if any(measurement is None for measurement in measurements.values()):
+        return None
+    return measurements
+
+def ratio(ours: int, reference: int) -> float:
+    return ours / reference if reference > 0 else float("nan")
+
+def geometric_mean(values: List[float]) -> float:
+    values = [value for value in values if value > 0 and not math.isnan(value)]
+    if not values:
+        return float("nan")
+    return math.exp(sum(math.log(value) for value in values) / len(values))
+
+def write_benchmark_report(benchmarks: Dict[str, Dict[str, Measurement]]):
+    """
+    Per-test instruction counts and .text sizes, with our compiler's ratio
+    to each gcc level and the geometric mean of the ratios at the bottom.
+    """
+    compilers = [OURS] + [f"gcc {level}" for level in REFERENCE_LEVELS]
+    header = f"{'test':<40}"
+    for metric in ("instructions", "text_size"):
+        header += "".join(f"{compiler + ' ' + metric:>26}" for compiler in compilers)
+        header += "".join(f"{'/' + compiler:>12}" for compiler in compilers[1:])
+    lines = [header]
+    ratios = {(metric, compiler): [] for metric in ("instructions", "text_size") for compiler in compilers[1:]}
+    for test in sorted(benchmarks):
+        line = f"{test:<40}"
+        for metric in ("instructions", "text_size"):
+            values = {compiler: getattr(benchmarks[test][compiler], metric) for compiler in compilers}
+            line += "".join(f"{values[compiler]:>26}" for compiler in compilers)
+            for compiler in compilers[1:]:
+                value = ratio(values[OURS], values[compiler])
+                ratios[(metric, compiler)].append(value)
+                line += f"{value:>12.3f}"
+        lines.append(line)
+    summary = f"{'geometric mean':<40}"
+    for metric in ("instructions", "text_size"):
+        summary += " " * 26 * len(compilers)
+        summary += "".join(f"{geometric_mean(ratios[(metric, compiler)]):>12.3f}" for compiler in compilers[1:])
+    lines.append(summary)
+    BENCHMARK_REPORT_FILE.parent.mkdir(parents=True, exist_ok=True)
+    with open(BENCHMARK_REPORT_FILE, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print(f"Benchmark report written to: {BENCHMARK_REPORT_FILE}")
+
+def check_baseline(benchmarks: Dict[str, Dict[str, Measurement]], threshold: float, update: bool) -> bool:
+    """
+    Compare our compiler's numbers with the stored baseline, or replace the
+    baseline with them. Tests missing from the baseline are not checked.
+
+    Return True if nothing regressed by more than the threshold.
+    """
+    current = {test: asdict(benchmarks[test][OURS]) for test in sorted(benchmarks)}
+    if update:
+        with open(BENCHMARK_BASELINE_FILE, "w") as f:
+            json.dump(current, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print(GREEN + f"Benchmark baseline updated: {BENCHMARK_BASELINE_FILE}" + RESET)
+        return True
+    if not BENCHMARK_BASELINE_FILE.exists():
+        print(f"No benchmark baseline at {BENCHMARK_BASELINE_FILE}; run with --update_baseline to create one.")
+        return True
+
+    with open(BENCHMARK_BASELINE_FILE) as f:
+        baseline = json.load(f)
+    regressions = []
+    for test, measurement in current.items():
+        for metric, value in measurement.items():
+            previous = baseline.get(test, {}).get(metric)
+            if previous is not None and value > previous * (1 + threshold):
+                regressions.append(f"{test}: {metric} {previous} -> {value} (+{ratio(value - previous, previous):.1%})")
+    for regression in regressions:
+        print(RED + "Regression: " + regression + RESET)
+    if not regressions:
+        print(GREEN + f"No benchmark regressions beyond {threshold:.1%}" + RESET)
+    return not regressions
 
 def run_subprocess(
     cmd: List[str],
@@ -399,6 +646,7 @@ def run_tests(args, xml_file: JUnitXMLFile):
     drivers = list(Path(args.dir).rglob("*_driver.c"))
     drivers = sorted(drivers, key=lambda p: (p.parent.name, p.name))
     results = []
+    benchmarks = {}
 
     progress_bar = None
     if args.short and sys.stdout.isatty():
@@ -407,27 +655,37 @@ def run_tests(args, xml_file: JUnitXMLFile):
         # Force verbose mode when not a terminal
         args.short = False
 
+    if args.batch:
+        compile_batch(drivers)
+
     if args.multithreading:
         with ThreadPoolExecutor() as executor:
-            futures = [executor.submit(run_test, driver) for driver in drivers]
+            futures = [executor.submit(run_test, driver, args.benchmark, args.batch) for driver in drivers]
             for future in as_completed(futures):
                 result = future.result()
                 results.append(result.passed)
+                if result.benchmark:
+                    benchmarks[str(result.test_case_name)] = result.benchmark
                 process_result(result, xml_file, not args.short, progress_bar)
 
     else:
         for driver in drivers:
-            result = run_test(driver)
+            result = run_test(driver, args.benchmark, args.batch)
             results.append(result.passed)
+            if result.benchmark:
+                benchmarks[str(result.test_case_name)] = result.benchmark
             process_result(result, xml_file, not args.short, progress_bar)
 
     passing = sum(results)
     total = len(drivers)
 
-    if args.short:
-        return
+    if not args.short:
+        print("\n>> Test Summary: " + GREEN + f"{passing} Passed, " + RED + f"{total-passing} Failed" + RESET)
 
-    print("\n>> Test Summary: " + GREEN + f"{passing} Passed, " + RED + f"{total-passing} Failed" + RESET)
+    if args.benchmark:
+        write_benchmark_report(benchmarks)
+        return check_baseline(benchmarks, args.threshold, args.update_baseline)
+    return True
 
 def parse_args():
     """
@@ -475,6 +733,34 @@ def parse_args():
         help="Run with coverage if you want to know which part of your code is "
         "executed when running your compiler. See docs/coverage.md"
     )
+    parser.add_argument(
+        "--batch",
+        action="store_true",
+        default=False,
+        help="Compile all the tests with a single run of the compiler before "
+        "assembling and running them, instead of one run per test."
+    )
+    parser.add_argument(
+        "--benchmark",
+        action="store_true",
+        default=False,
+        help="Also count the instructions spike runs and the .text size of each "
+        "passing test, for this compiler and gcc -O0/-O2. Fails if this compiler "
+        "regresses against the stored baseline."
+    )
+    parser.add_argument(
+        "--update_baseline",
+        action="store_true",
+        default=False,
+        help="With --benchmark, store this run's numbers as the new baseline."
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=DEFAULT_REGRESSION_THRESHOLD,
+        help="With --benchmark, the fraction a test's instruction count or "
+        f"size may grow over the baseline (default {DEFAULT_REGRESSION_THRESHOLD})."
+    )
     return parser.parse_args()
 
 def main():
@@ -491,13 +777,16 @@ def main():
         exit(3)
 
     with JUnitXMLFile(J_UNIT_OUTPUT_FILE) as xml_file:
-        run_tests(args, xml_file)
+        benchmarks_ok = run_tests(args, xml_file)
 
     if args.coverage:
         if not coverage():
             exit(4)
         serve_coverage_forever('0.0.0.0', 8000)
 
+    if not benchmarks_ok:
+        exit(5)
+
 if __name__ == "__main__":
     try:
         main()
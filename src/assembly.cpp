@@ -0,0 +1,336 @@
+#include <assembly.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace
+{
+    const std::set<std::string> storeOpcodes = {"sb", "sh", "sw", "fsw", "fsd"};
+    const std::set<std::string> loadOpcodes = {"lb", "lbu", "lh", "lhu", "lw", "flw", "fld"};
+    const std::set<std::string> branchOpcodes = {"beq", "bne", "blt", "bge", "bltu", "bgeu", "bgt", "ble", "bgtu", "bleu", "beqz", "bnez", "bltz", "bgez", "bgtz", "blez"};
+
+    std::string Trim(const std::string &text)
+    {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos)
+        {
+            return "";
+        }
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+}
+
+bool IsRegister(const std::string &operand)
+{
+    static const std::set<std::string> named = {"zero", "ra", "sp", "gp", "tp"};
+    if (named.count(operand))
+    {
+        return true;
+    }
+    std::string name = operand;
+    // Floating point registers are the integer names with an f in front
+    if (name.size() > 1 && name[0] == 'f' && name != "f")
+    {
+        name = name.substr(1);
+    }
+    if (name.size() < 2 || name.size() > 3)
+    {
+        return false;
+    }
+    char bank = name[0];
+    if (bank != 'x' && bank != 't' && bank != 's' && bank != 'a' && !(operand[0] == 'f' && isdigit(bank)))
+    {
+        return false;
+    }
+    std::string number = isdigit(bank) ? name : name.substr(1);
+    return !number.empty() && std::all_of(number.begin(), number.end(), ::isdigit);
+}
+
+bool IsCallerSaved(const std::string &reg)
+{
+    if (!IsRegister(reg))
+    {
+        return false;
+    }
+    std::string name = reg[0] == 'f' ? reg.substr(1) : reg;
+    return reg == "ra" || name[0] == 't' || name[0] == 'a';
+}
+
+std::vector<std::string> CallerSavedRegisters()
+{
+    std::vector<std::string> registers = {"ra"};
+    for (int i = 0; i <= 11; i++)
+    {
+        if (i <= 6)
+        {
+            registers.push_back("t" + std::to_string(i));
+        }
+        if (i <= 7)
+        {
+            registers.push_back("a" + std::to_string(i));
+            registers.push_back("fa" + std::to_string(i));
+        }
+        registers.push_back("ft" + std::to_string(i));
+    }
+    return registers;
+}
+
+bool SplitMemoryOperand(const std::string &operand, std::string &offset, std::string &base)
+{
+    // The offset can be a relocation such as %lo(symbol), so the base is in
+    // the last parentheses
+    size_t open = operand.rfind('(');
+    if (open == std::string::npos || operand.back() != ')' || !IsRegister(operand.substr(open + 1, operand.size() - open - 2)))
+    {
+        return false;
+    }
+    offset = operand.substr(0, open);
+    base = operand.substr(open + 1, operand.size() - open - 2);
+    return true;
+}
+
+bool IsLocalLabel(const std::string &label)
+{
+    if (label.size() < 2 || label[0] != 'L')
+    {
+        return false;
+    }
+    size_t digits = label.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 1);
+    return digits != std::string::npos && label.find_first_not_of("0123456789", digits) == std::string::npos;
+}
+
+std::string InvertedBranch(const std::string &opcode)
+{
+    static const std::map<std::string, std::string> inverse = {
+        {"beq", "bne"}, {"bne", "beq"}, {"blt", "bge"}, {"bge", "blt"}, {"bltu", "bgeu"}, {"bgeu", "bltu"},
+        {"bgt", "ble"}, {"ble", "bgt"}, {"bgtu", "bleu"}, {"bleu", "bgtu"},
+        {"beqz", "bnez"}, {"bnez", "beqz"}, {"bltz", "bgez"}, {"bgez", "bltz"}, {"bgtz", "blez"}, {"blez", "bgtz"},
+    };
+    auto inverted = inverse.find(opcode);
+    return inverted == inverse.end() ? "" : inverted->second;
+}
+
+bool AssemblyLine::isLabel() const
+{
+    return !label.empty();
+}
+
+bool AssemblyLine::isDirective() const
+{
+    return !opcode.empty() && opcode[0] == '.';
+}
+
+bool AssemblyLine::isInstruction() const
+{
+    return !isLabel() && !opcode.empty() && !isDirective();
+}
+
+bool AssemblyLine::isStore() const
+{
+    return storeOpcodes.count(opcode) > 0;
+}
+
+bool AssemblyLine::isLoad() const
+{
+    return loadOpcodes.count(opcode) > 0;
+}
+
+bool AssemblyLine::isConditionalBranch() const
+{
+    return branchOpcodes.count(opcode) > 0;
+}
+
+bool AssemblyLine::isJump() const
+{
+    return opcode == "j" || opcode == "jr";
+}
+
+bool AssemblyLine::isCall() const
+{
+    return opcode == "call" || opcode == "tail" || opcode == "jal" || opcode == "jalr";
+}
+
+bool AssemblyLine::isReturn() const
+{
+    return opcode == "ret" || (opcode == "jr" && operands.size() == 1 && operands[0] == "ra");
+}
+
+bool AssemblyLine::isMove() const
+{
+    return (opcode == "mv" || opcode == "fmv.s" || opcode == "fmv.d") && operands.size() == 2;
+}
+
+bool AssemblyLine::endsBlock() const
+{
+    return isConditionalBranch() || isJump() || isCall() || isReturn();
+}
+
+std::string AssemblyLine::definedRegister() const
+{
+    if (!isInstruction() || operands.empty() || isStore() || endsBlock())
+    {
+        return "";
+    }
+    if (!IsRegister(operands[0]))
+    {
+        return "";
+    }
+    return operands[0];
+}
+
+std::vector<std::string> AssemblyLine::usedRegisters() const
+{
+    std::vector<std::string> used;
+    if (!isInstruction())
+    {
+        return used;
+    }
+    size_t first = definedRegister().empty() ? 0 : 1;
+    for (size_t i = first; i < operands.size(); i++)
+    {
+        std::string offset, base;
+        if (SplitMemoryOperand(operands[i], offset, base))
+        {
+            used.push_back(base);
+        }
+        else if (IsRegister(operands[i]))
+        {
+            used.push_back(operands[i]);
+        }
+    }
+    if (isReturn() && opcode == "ret")
+    {
+        used.push_back("ra");
+    }
+    return used;
+}
+
+bool AssemblyLine::uses(const std::string &reg) const
+{
+    std::vector<std::string> used = usedRegisters();
+    return std::find(used.begin(), used.end(), reg) != used.end();
+}
+
+void AssemblyLine::replaceUses(const std::string &from, const std::string &to)
+{
+    if (!isInstruction())
+    {
+        return;
+    }
+    size_t first = definedRegister().empty() ? 0 : 1;
+    for (size_t i = first; i < operands.size(); i++)
+    {
+        std::string offset, base;
+        if (SplitMemoryOperand(operands[i], offset, base))
+        {
+            if (base == from)
+            {
+                operands[i] = offset + "(" + to + ")";
+            }
+        }
+        else if (operands[i] == from)
+        {
+            operands[i] = to;
+        }
+    }
+}
+
+void AssemblyLine::setDefinedRegister(const std::string &reg)
+{
+    if (!definedRegister().empty())
+    {
+        operands[0] = reg;
+    }
+}
+
+std::string AssemblyLine::target() const
+{
+    if ((isConditionalBranch() || opcode == "j") && !operands.empty())
+    {
+        return operands.back();
+    }
+    return "";
+}
+
+void AssemblyLine::setTarget(const std::string &label)
+{
+    if (!target().empty())
+    {
+        operands.back() = label;
+    }
+}
+
+std::string AssemblyLine::toString() const
+{
+    if (isLabel())
+    {
+        return label + ":";
+    }
+    std::string text = opcode;
+    for (size_t i = 0; i < operands.size(); i++)
+    {
+        text += (i == 0 ? " " : ", ") + operands[i];
+    }
+    return text;
+}
+
+AssemblyLine MakeInstruction(const std::string &opcode, const std::vector<std::string> &operands)
+{
+    AssemblyLine line;
+    line.opcode = opcode;
+    line.operands = operands;
+    return line;
+}
+
+std::vector<AssemblyLine> ParseAssembly(std::istream &input)
+{
+    std::vector<AssemblyLine> code;
+    std::string text;
+    while (std::getline(input, text))
+    {
+        text = Trim(text);
+        if (text.empty())
+        {
+            continue;
+        }
+        AssemblyLine line;
+        if (text.back() == ':' && text.find_first_of(" \t") == std::string::npos)
+        {
+            line.label = text.substr(0, text.size() - 1);
+            code.push_back(line);
+            continue;
+        }
+        size_t space = text.find_first_of(" \t");
+        line.opcode = text.substr(0, space);
+        if (space != std::string::npos)
+        {
+            std::stringstream operands(text.substr(space + 1));
+            std::string operand;
+            // Directives such as .string keep their argument text as it is
+            if (line.isDirective())
+            {
+                line.operands.push_back(Trim(text.substr(space + 1)));
+            }
+            else
+            {
+                while (std::getline(operands, operand, ','))
+                {
+                    line.operands.push_back(Trim(operand));
+                }
+            }
+        }
+        code.push_back(line);
+    }
+    return code;
+}
+
+void WriteAssembly(std::ostream &output, const std::vector<AssemblyLine> &code)
+{
+    for (const auto &line : code)
+    {
+        output << line.toString() << std::endl;
+    }
+}
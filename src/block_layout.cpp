@@ -0,0 +1,530 @@
+#include <block_layout.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace
+{
+    // How control leaves a block
+    enum BlockExit
+    {
+        FALLS_THROUGH,
+        BRANCHES,
+        JUMPS,
+        RETURNS,
+    };
+
+    // Straight-line run of instructions, only entered at the top
+    struct Block
+    {
+        std::vector<std::string> labels;
+        std::vector<AssemblyLine> instructions;
+        BlockExit exit = FALLS_THROUGH;
+        size_t start = 0;      // Position of the first instruction
+        long long count = -1;  // Times it ran, if there is a profile
+        int taken = -1;        // Block a branch or jump goes to
+        int fallthrough = -1;  // Next block in source order, if control can reach it
+        bool likelyTaken = false;
+        bool unlikelyTaken = false;
+        bool unlikelyFallthrough = false;
+        bool loopHeader = false;
+    };
+
+    // Numbered on from the number of labels there are, rather than from a
+    // counter kept across calls, so the names only depend on this file
+    std::string NewLabel(std::set<std::string> &labels)
+    {
+        size_t count = labels.size();
+        std::string label;
+        do
+        {
+            label = "LB" + std::to_string(++count);
+        } while (labels.count(label));
+        labels.insert(label);
+        return label;
+    }
+
+    bool IsSectionDirective(const AssemblyLine &line)
+    {
+        return line.opcode == ".text" || line.opcode == ".section" || line.opcode == ".data" || line.opcode == ".bss" || line.opcode == ".rodata";
+    }
+
+    bool IsUnlikelySection(const AssemblyLine &section)
+    {
+        return section.opcode == ".section" && !section.operands.empty() && section.operands[0].compare(0, 14, ".text.unlikely") == 0;
+    }
+
+    // A function runs from its name to the next directive or name
+    bool IsFunctionStart(const AssemblyLine &line)
+    {
+        return line.isLabel() && !IsLocalLabel(line.label);
+    }
+
+    size_t FunctionEnd(const std::vector<AssemblyLine> &code, size_t begin)
+    {
+        size_t end = begin + 1;
+        while (end < code.size() && !code[end].isDirective() && !IsFunctionStart(code[end]))
+        {
+            end++;
+        }
+        return end;
+    }
+
+    // Split the function in code[begin, end) into blocks and link them up.
+    // Fails if control can leave the function other than by returning, e.g.
+    // through a computed jump or a jump to a label outside it.
+    bool SplitBlocks(const std::vector<AssemblyLine> &code, size_t begin, size_t end, std::vector<Block> &blocks)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const AssemblyLine &line = code[i];
+            if (line.isLabel())
+            {
+                if (blocks.empty() || !blocks.back().instructions.empty())
+                {
+                    blocks.push_back(Block());
+                }
+                blocks.back().labels.push_back(line.label);
+                continue;
+            }
+            if (blocks.back().exit != FALLS_THROUGH)
+            {
+                blocks.push_back(Block());
+            }
+            Block &block = blocks.back();
+            if (block.instructions.empty())
+            {
+                block.start = i;
+            }
+            block.instructions.push_back(line);
+            if (line.isConditionalBranch())
+            {
+                block.exit = BRANCHES;
+            }
+            else if (line.opcode == "j")
+            {
+                block.exit = JUMPS;
+            }
+            else if (line.isReturn() || line.opcode == "tail")
+            {
+                block.exit = RETURNS;
+            }
+            else if (line.isJump())
+            {
+                return false;
+            }
+        }
+
+        std::map<std::string, int> blockOf;
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            for (auto &label : blocks[k].labels)
+            {
+                blockOf[label] = k;
+            }
+        }
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            Block &block = blocks[k];
+            if (block.exit == BRANCHES || block.exit == JUMPS)
+            {
+                auto target = blockOf.find(block.instructions.back().target());
+                if (target == blockOf.end() || target->second == 0)
+                {
+                    return false;
+                }
+                block.taken = target->second;
+            }
+            if (block.exit == BRANCHES || block.exit == FALLS_THROUGH)
+            {
+                if (k + 1 >= blocks.size())
+                {
+                    return false;
+                }
+                block.fallthrough = k + 1;
+            }
+        }
+        return true;
+    }
+
+    // The block jumps to the return, skipping code that still branches,
+    // loops or calls. Just skipping straight-line code is the join of a conditional
+    // value such as `x && y`, which is no guide either way.
+    bool ReturnsEarly(const std::vector<Block> &blocks, int k)
+    {
+        const Block &block = blocks[k];
+        if (block.exit != JUMPS || blocks[block.taken].exit != RETURNS)
+        {
+            return false;
+        }
+        for (int skipped = k + 1; skipped < block.taken; skipped++)
+        {
+            if (blocks[skipped].exit == BRANCHES || blocks[skipped].exit == JUMPS)
+            {
+                return true;
+            }
+            for (auto &line : blocks[skipped].instructions)
+            {
+                if (line.isCall())
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Guess which way each branch goes, and find loop headers
+    void PredictBranches(std::vector<Block> &blocks)
+    {
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            Block &block = blocks[k];
+            if (block.taken != -1 && block.taken <= (int)k)
+            {
+                blocks[block.taken].loopHeader = true;
+            }
+            if (block.exit != BRANCHES)
+            {
+                continue;
+            }
+            bool earlyTaken = ReturnsEarly(blocks, block.taken);
+            bool earlyFallthrough = ReturnsEarly(blocks, block.fallthrough);
+            if (earlyTaken != earlyFallthrough)
+            {
+                block.unlikelyTaken = earlyTaken;
+                block.unlikelyFallthrough = earlyFallthrough;
+            }
+            block.likelyTaken = (block.taken <= (int)k && !block.unlikelyTaken) || block.unlikelyFallthrough;
+        }
+    }
+
+    std::vector<int> CountPredecessors(const std::vector<Block> &blocks)
+    {
+        std::vector<int> predecessors(blocks.size(), 0);
+        for (auto &block : blocks)
+        {
+            for (int next : {block.taken, block.fallthrough})
+            {
+                if (next != -1)
+                {
+                    predecessors[next]++;
+                }
+            }
+        }
+        return predecessors;
+    }
+
+    // Replace the guesses with what the profile saw. Only block counts are
+    // recorded, so the count of an edge is worked out from a successor that
+    // cannot be reached any other way.
+    void ApplyProfile(std::vector<Block> &blocks, const std::vector<long long> &counts)
+    {
+        std::vector<int> predecessors = CountPredecessors(blocks);
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            blocks[k].count = counts[k];
+        }
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            Block &block = blocks[k];
+            if (block.exit != BRANCHES)
+            {
+                continue;
+            }
+            long long taken = counts[block.taken];
+            long long fallthrough = counts[block.fallthrough];
+            if (predecessors[block.fallthrough] == 1)
+            {
+                taken = counts[k] - fallthrough;
+            }
+            else if (predecessors[block.taken] == 1)
+            {
+                fallthrough = counts[k] - taken;
+            }
+            block.likelyTaken = taken > fallthrough;
+        }
+    }
+
+    // Blocks that ran, if there is a profile, or else those reached from the
+    // entry without taking an unlikely edge. The return itself is always
+    // hot, even if only cold blocks lead to it.
+    std::vector<bool> FindHotBlocks(const std::vector<Block> &blocks)
+    {
+        std::vector<bool> hot(blocks.size(), false);
+        if (blocks[0].count > 0)
+        {
+            for (size_t k = 0; k < blocks.size(); k++)
+            {
+                hot[k] = blocks[k].count > 0 || blocks[k].exit == RETURNS;
+            }
+            return hot;
+        }
+        std::vector<int> worklist = {0};
+        hot[0] = true;
+        while (!worklist.empty())
+        {
+            const Block &block = blocks[worklist.back()];
+            worklist.pop_back();
+            for (int next : {block.unlikelyTaken ? -1 : block.taken, block.unlikelyFallthrough ? -1 : block.fallthrough})
+            {
+                if (next != -1 && !hot[next])
+                {
+                    hot[next] = true;
+                    worklist.push_back(next);
+                }
+            }
+        }
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            hot[k] = hot[k] || blocks[k].exit == RETURNS;
+        }
+        return hot;
+    }
+
+    // Chain the hot blocks from the entry, following the likely successor of
+    // each so that it falls through. A jump is followed when nothing else
+    // leads to its target, so no other fallthrough is broken.
+    std::vector<int> OrderHotBlocks(const std::vector<Block> &blocks, const std::vector<bool> &hot)
+    {
+        std::vector<int> predecessors = CountPredecessors(blocks);
+        std::vector<bool> placed(blocks.size(), false);
+        auto open = [&](int k) { return k != -1 && hot[k] && !placed[k]; };
+        std::vector<int> order;
+        int current = 0;
+        while (current != -1)
+        {
+            placed[current] = true;
+            order.push_back(current);
+            const Block &block = blocks[current];
+            int likely = block.likelyTaken ? block.taken : block.fallthrough;
+            int unlikely = block.likelyTaken ? block.fallthrough : block.taken;
+            current = -1;
+            if (block.exit == BRANCHES)
+            {
+                current = open(likely) ? likely : open(unlikely) ? unlikely : -1;
+            }
+            else if (block.exit == JUMPS && open(block.taken) && predecessors[block.taken] == 1)
+            {
+                current = block.taken;
+            }
+            else if (block.exit == FALLS_THROUGH && open(block.fallthrough))
+            {
+                current = block.fallthrough;
+            }
+            for (size_t k = 0; current == -1 && k < blocks.size(); k++)
+            {
+                if (open(k))
+                {
+                    current = k;
+                }
+            }
+        }
+        return order;
+    }
+
+    std::string LabelOf(std::vector<Block> &blocks, int k, std::set<std::string> &labels)
+    {
+        if (blocks[k].labels.empty())
+        {
+            blocks[k].labels.push_back(NewLabel(labels));
+        }
+        return blocks[k].labels.front();
+    }
+
+    // Lay out one function's blocks, hot ones in the order given and cold
+    // ones after them in .text.unlikely, fixing up branches and jumps for
+    // the new order. A conditional branch cannot reach across sections, so
+    // it goes through a jump at the end of its own section instead.
+    void EmitBlocks(std::vector<Block> &blocks, const std::vector<int> &order, const std::vector<bool> &hot, const AssemblyLine &section, std::set<std::string> &labels, std::vector<AssemblyLine> &code)
+    {
+        std::vector<int> cold;
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            if (!hot[k])
+            {
+                cold.push_back(k);
+            }
+        }
+
+        std::vector<std::vector<AssemblyLine>> bodies(blocks.size());
+        std::vector<std::pair<std::string, std::string>> trampolines[2];
+        auto reach = [&](bool fromCold, int target, bool conditional) {
+            std::string label = LabelOf(blocks, target, labels);
+            if (!conditional || fromCold == !hot[target])
+            {
+                return label;
+            }
+            for (auto &trampoline : trampolines[fromCold])
+            {
+                if (trampoline.second == label)
+                {
+                    return trampoline.first;
+                }
+            }
+            trampolines[fromCold].push_back({NewLabel(labels), label});
+            return trampolines[fromCold].back().first;
+        };
+        for (bool fromCold : {false, true})
+        {
+            const std::vector<int> &placement = fromCold ? cold : order;
+            for (size_t i = 0; i < placement.size(); i++)
+            {
+                int k = placement[i];
+                int next = i + 1 < placement.size() ? placement[i + 1] : -1;
+                const Block &block = blocks[k];
+                std::vector<AssemblyLine> &body = bodies[k];
+                body = block.instructions;
+                int fallthrough = block.fallthrough;
+                if (block.exit == BRANCHES)
+                {
+                    int taken = block.taken;
+                    std::string inverted = InvertedBranch(body.back().opcode);
+                    if (next == taken && next != fallthrough && !inverted.empty())
+                    {
+                        body.back().opcode = inverted;
+                        std::swap(taken, fallthrough);
+                    }
+                    body.back().setTarget(reach(fromCold, taken, true));
+                }
+                else if (block.exit == JUMPS)
+                {
+                    body.pop_back();
+                    fallthrough = block.taken;
+                }
+                if (fallthrough != -1 && fallthrough != next)
+                {
+                    body.push_back(MakeInstruction("j", {reach(fromCold, fallthrough, false)}));
+                }
+            }
+        }
+
+        auto emit = [&](const std::vector<int> &placement, bool fromCold) {
+            for (int k : placement)
+            {
+                if (blocks[k].loopHeader && !fromCold)
+                {
+                    code.push_back(MakeInstruction(".align", {"3"}));
+                }
+                for (auto &label : blocks[k].labels)
+                {
+                    AssemblyLine line;
+                    line.label = label;
+                    code.push_back(line);
+                }
+                code.insert(code.end(), bodies[k].begin(), bodies[k].end());
+            }
+            for (auto &trampoline : trampolines[fromCold])
+            {
+                AssemblyLine line;
+                line.label = trampoline.first;
+                code.push_back(line);
+                code.push_back(MakeInstruction("j", {trampoline.second}));
+            }
+        };
+        emit(order, false);
+        if (cold.empty())
+        {
+            return;
+        }
+        // Each function has its own unlikely section when it has its own
+        // text section, so unused functions can still be dropped whole
+        const std::string &function = blocks[0].labels.front();
+        std::string prefix = ".text." + function + ",";
+        bool ownSection = section.opcode == ".section" && !section.operands.empty() && section.operands[0].compare(0, prefix.size(), prefix) == 0;
+        code.push_back(MakeInstruction(".section", {std::string(".text.unlikely") + (ownSection ? "." + function : "") + ",\"ax\",@progbits"}));
+        emit(cold, true);
+        code.push_back(section);
+    }
+}
+
+std::map<std::string, std::vector<size_t>> FindBasicBlocks(const std::vector<AssemblyLine> &code)
+{
+    std::map<std::string, std::vector<size_t>> functions;
+    for (size_t i = 0; i < code.size(); i++)
+    {
+        if (!IsFunctionStart(code[i]))
+        {
+            continue;
+        }
+        size_t end = FunctionEnd(code, i);
+        std::vector<Block> blocks;
+        if (SplitBlocks(code, i, end, blocks))
+        {
+            for (auto &block : blocks)
+            {
+                functions[code[i].label].push_back(block.start);
+            }
+        }
+        i = end - 1;
+    }
+    return functions;
+}
+
+int RunBlockLayout(std::vector<AssemblyLine> &code, const Profile *profile)
+{
+    std::set<std::string> labels;
+    for (auto &line : code)
+    {
+        if (line.isLabel())
+        {
+            labels.insert(line.label);
+        }
+    }
+
+    int moved = 0;
+    std::vector<AssemblyLine> laidOut;
+    AssemblyLine section = MakeInstruction(".text", {});
+    size_t i = 0;
+    while (i < code.size())
+    {
+        if (!IsFunctionStart(code[i]))
+        {
+            if (IsSectionDirective(code[i]))
+            {
+                section = code[i];
+            }
+            laidOut.push_back(code[i++]);
+            continue;
+        }
+        size_t end = FunctionEnd(code, i);
+        std::vector<Block> blocks;
+        if (!SplitBlocks(code, i, end, blocks))
+        {
+            laidOut.insert(laidOut.end(), code.begin() + i, code.begin() + end);
+            i = end;
+            continue;
+        }
+        PredictBranches(blocks);
+        if (profile != nullptr)
+        {
+            // Counts for a different build of the function are no use
+            auto counts = profile->blockCounts.find(code[i].label);
+            if (counts != profile->blockCounts.end() && counts->second.size() == blocks.size())
+            {
+                ApplyProfile(blocks, counts->second);
+            }
+        }
+        std::vector<bool> hot = FindHotBlocks(blocks);
+        // A function that is cold as a whole is not split any further
+        if (IsUnlikelySection(section))
+        {
+            hot.assign(blocks.size(), true);
+        }
+        std::vector<int> order = OrderHotBlocks(blocks, hot);
+        for (size_t k = 0; k < blocks.size(); k++)
+        {
+            moved += !hot[k];
+        }
+        for (size_t j = 1; j < order.size(); j++)
+        {
+            moved += order[j] != order[j - 1] + 1;
+        }
+        EmitBlocks(blocks, order, hot, section, labels, laidOut);
+        i = end;
+    }
+    code = laidOut;
+    return moved;
+}
@@ -1,5 +1,43 @@
 #include <cli.h>
 
+#include <fstream>
+#include <sstream>
+
+#include <scheduler.h>
+
+namespace
+{
+    // A manifest lists one file per line, its source and then its output,
+    // separated by whitespace. Blank lines and lines starting with # are
+    // skipped.
+    void ReadManifest(const std::string &path, std::vector<SourceFile> &files)
+    {
+        std::ifstream manifest(path);
+        if (!manifest)
+        {
+            fprintf(stderr, "Couldn't open manifest `%s'.\n", path.c_str());
+            exit(2);
+        }
+        std::string line;
+        for (int number = 1; std::getline(manifest, line); number++)
+        {
+            std::istringstream fields(line);
+            SourceFile file;
+            if (!(fields >> file.source_path) || file.source_path[0] == '#')
+            {
+                continue;
+            }
+            std::string extra;
+            if (!(fields >> file.output_path) || fields >> extra)
+            {
+                fprintf(stderr, "Line %d of manifest `%s' should be a source and an output path.\n", number, path.c_str());
+                exit(2);
+            }
+            files.push_back(file);
+        }
+    }
+}
+
 CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
 {
     std::string input = "";
@@ -17,21 +55,132 @@ CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
     // Prevent opterr messages from being outputted.
     opterr = 0;
 
+    // Options that only have a long form, e.g. -funroll-factor=4
+    enum LongOption
+    {
+        UNROLL_FACTOR = 256,
+        NO_PEEPHOLE,
+        NO_COPY_PROPAGATION,
+        NO_JUMP_THREADING,
+        NO_REORDER_BLOCKS,
+        NO_SCHEDULE,
+        NO_FUNCTION_SECTIONS,
+        PROFILE_GENERATE,
+        PROFILE_USE,
+        TUNE,
+        TIME_REPORT,
+        STATS,
+        STATS_JSON,
+        MANIFEST,
+        STREAMING,
+    };
+    static const struct option long_options[] = {
+        {"funroll-factor", required_argument, nullptr, UNROLL_FACTOR},
+        {"fno-peephole", no_argument, nullptr, NO_PEEPHOLE},
+        {"fno-copy-propagation", no_argument, nullptr, NO_COPY_PROPAGATION},
+        {"fno-jump-threading", no_argument, nullptr, NO_JUMP_THREADING},
+        {"fno-reorder-blocks", no_argument, nullptr, NO_REORDER_BLOCKS},
+        {"fno-schedule", no_argument, nullptr, NO_SCHEDULE},
+        {"fno-function-sections", no_argument, nullptr, NO_FUNCTION_SECTIONS},
+        {"fprofile-generate", optional_argument, nullptr, PROFILE_GENERATE},
+        {"fprofile-use", optional_argument, nullptr, PROFILE_USE},
+        {"mtune", required_argument, nullptr, TUNE},
+        {"ftime-report", no_argument, nullptr, TIME_REPORT},
+        {"stats", no_argument, nullptr, STATS},
+        {"fstats-json", required_argument, nullptr, STATS_JSON},
+        {"fmanifest", required_argument, nullptr, MANIFEST},
+        {"fstreaming", no_argument, nullptr, STREAMING},
+        {nullptr, 0, nullptr, 0},
+    };
+
     // ./bin/c_compiler -S [source-file.c] -o [dest-file.s]
+    // The n-th -S goes with the n-th -o, so several files can be compiled at
+    // once, as can the files of a manifest
     CommandLineArguments cli_args;
+    std::vector<std::string> sources, outputs, manifests;
     int opt;
-    while ((opt = getopt(argc, argv, "S:o:")) != -1)
+    while ((opt = getopt_long_only(argc, argv, "S:o:j:", long_options, nullptr)) != -1)
     {
         switch (opt)
         {
         case 'S':
-            cli_args.compile_source_path = std::string(optarg);
+            sources.push_back(std::string(optarg));
             break;
         case 'o':
-            cli_args.compile_output_path = std::string(optarg);
+            outputs.push_back(std::string(optarg));
+            break;
+        case 'j':
+            cli_args.jobs = atoi(optarg);
+            if (cli_args.jobs < 1)
+            {
+                fprintf(stderr, "Option -j requires a positive number of jobs.\n");
+                exit(2);
+            }
+            break;
+        case MANIFEST:
+            manifests.push_back(std::string(optarg));
+            break;
+        case UNROLL_FACTOR:
+            cli_args.unroll_factor = atoi(optarg);
+            if (cli_args.unroll_factor < 1)
+            {
+                fprintf(stderr, "Option -funroll-factor requires a positive factor.\n");
+                exit(2);
+            }
+            break;
+        case NO_PEEPHOLE:
+            cli_args.peephole = false;
+            break;
+        case NO_COPY_PROPAGATION:
+            cli_args.copy_propagation = false;
+            break;
+        case NO_JUMP_THREADING:
+            cli_args.jump_threading = false;
+            break;
+        case NO_REORDER_BLOCKS:
+            cli_args.reorder_blocks = false;
+            break;
+        case NO_SCHEDULE:
+            cli_args.schedule = false;
+            break;
+        case NO_FUNCTION_SECTIONS:
+            cli_args.function_sections = false;
+            break;
+        case PROFILE_GENERATE:
+        case PROFILE_USE:
+            (opt == PROFILE_GENERATE ? cli_args.profile_generate : cli_args.profile_use) = true;
+            if (optarg != nullptr)
+            {
+                cli_args.profile_path = std::string(optarg);
+            }
+            if (cli_args.profile_generate && cli_args.profile_use)
+            {
+                fprintf(stderr, "Options -fprofile-generate and -fprofile-use cannot be combined.\n");
+                exit(2);
+            }
+            break;
+        case TUNE:
+            cli_args.tune = std::string(optarg);
+            if (FindPipelineModel(cli_args.tune) == nullptr)
+            {
+                fprintf(stderr, "Unknown core `%s' for -mtune.\n", optarg);
+                exit(2);
+            }
+            break;
+        case TIME_REPORT:
+            cli_args.time_report = true;
+            break;
+        case STATS:
+            cli_args.stats = true;
+            break;
+        case STATS_JSON:
+            cli_args.stats_json_path = std::string(optarg);
+            break;
+        case STREAMING:
+            cli_args.streaming = true;
             break;
         case '?':
-            if (optopt == 'S' || optopt == 'o')
+            if (optopt == 'S' || optopt == 'o' || optopt == 'j')
             {
                 fprintf(stderr, "Option -%c requires an argument.\n", optopt);
             }
@@ -48,17 +197,47 @@ CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
         }
     }
 
-    if (cli_args.compile_source_path.length() == 0)
+    // The counter table of an instrumented build lists every function, so
+    // it cannot be written until the whole file has been compiled
+    if (cli_args.streaming && cli_args.profile_generate)
+    {
+        fprintf(stderr, "Options -fstreaming and -fprofile-generate cannot be combined.\n");
+        exit(2);
+    }
+
+    if (sources.empty() && manifests.empty())
     {
         std::cerr << "The source path -S argument was not set." << std::endl;
         exit(2);
     }
 
-    if (cli_args.compile_output_path.length() == 0)
+    if (outputs.size() < sources.size())
     {
         std::cerr << "The output path -o argument was not set." << std::endl;
         exit(2);
     }
 
+    if (outputs.size() > sources.size())
+    {
+        std::cerr << "There are more -o arguments than -S arguments." << std::endl;
+        exit(2);
+    }
+
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        cli_args.files.push_back({sources[i], outputs[i]});
+    }
+    for (auto &manifest : manifests)
+    {
+        ReadManifest(manifest, cli_args.files);
+    }
+    if (cli_args.files.empty())
+    {
+        std::cerr << "The manifest lists no files." << std::endl;
+        exit(2);
+    }
+    cli_args.compile_source_path = cli_args.files[0].source_path;
+    cli_args.compile_output_path = cli_args.files[0].output_path;
+
     return cli_args;
 }
@@ -1,66 +1,513 @@
+#include <filesystem>
 #include <fstream>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 #include "cli.h"
 #include "ast.hpp"
+#include "assembly.h"
+#include "peephole.h"
+#include "copy_propagation.h"
+#include "jump_threading.h"
+#include "block_layout.h"
+#include "profile.h"
+#include "scheduler.h"
+#include "statistics.h"
 
-Node *Parse(CommandLineArguments &args)
+// Files compiled at the same time share stdout and stderr, so each line is
+// written in one piece
+void PrintLine(std::ostream &stream, const std::string &line)
 {
-    std::cout << "Parsing: " << args.compile_source_path << std::endl;
-    auto root = ParseAST(args.compile_source_path);
-    std::cout << "AST parsing complete" << std::endl;
-    return root;
+    static std::mutex outputMutex;
+    std::lock_guard<std::mutex> lock(outputMutex);
+    stream << line << std::endl;
+}
+
+// Parse the file, handing each declaration to the given backend as soon as
+// it is parsed if there is one
+ParserState Parse(CommandLineArguments &args, CompilationStatistics &statistics, std::function<void(Node *)> declaration = nullptr)
+{
+    PrintLine(std::cout, "Parsing: " + args.compile_source_path);
+    // The lexer and the backend run inside the parser, so their time is
+    // taken out of the parsing time
+    PhaseTiming lexing, backend;
+    ParserState parsed;
+    if (statistics.timing)
+    {
+        statistics.phase("lexing");
+        if (declaration)
+        {
+            declaration = [&backend, declaration](Node *node)
+            {
+                ResourceSnapshot start = TakeSnapshot();
+                declaration(node);
+                backend.add(start, TakeSnapshot());
+            };
+        }
+    }
+    {
+        PhaseTimer timer(statistics, "parsing");
+        parsed = ParseAST(args.compile_source_path, statistics.timing ? &lexing : nullptr, declaration);
+    }
+    if (statistics.timing)
+    {
+        statistics.phase("lexing").add(lexing);
+        statistics.phase("parsing").subtract(lexing);
+        statistics.phase("parsing").subtract(backend);
+    }
+    if (parsed.error.empty())
+    {
+        PrintLine(std::cout, "AST parsing complete");
+    }
+    return parsed;
 }
 
 // Output the pretty print version of what was parsed to the .printed output
 // file.
-void PrettyPrint(Node *root, CommandLineArguments &args)
+void PrettyPrint(Node *root, CommandLineArguments &args, CompilationStatistics &statistics)
 {
     auto output_path = args.compile_output_path + ".printed";
 
-    std::cout << "Printing parsed AST..." << std::endl;
+    PrintLine(std::cout, "Printing parsed AST...");
+    PhaseTimer timer(statistics, "printing");
     std::ofstream output(output_path, std::ios::trunc);
     root->Print(output);
     output.close();
-    std::cout << "Printed parsed AST to: " << output_path << std::endl;
+    PrintLine(std::cout, "Printed parsed AST to: " + output_path);
+}
+
+// Where the profile of this file is written and read: the given path, or
+// the output path with a .profile extension. It is made absolute, since the
+// instrumented program may run somewhere else.
+std::string ProfilePath(CommandLineArguments &args)
+{
+    std::filesystem::path path = args.profile_path;
+    if (path.empty())
+    {
+        path = std::filesystem::path(args.compile_output_path).replace_extension(".profile");
+    }
+    return std::filesystem::absolute(path).string();
+}
+
+// Conditional branches and jumps, to count the ones the passes remove
+int CountBranches(const std::vector<AssemblyLine> &code)
+{
+    int branches = 0;
+    for (auto &line : code)
+    {
+        branches += line.isConditionalBranch() || line.opcode == "j";
+    }
+    return branches;
+}
+
+// Run a pass over the assembly as a phase of its own, adding what it
+// returns to the given counter
+int RunPass(CompilationStatistics &statistics, const std::string &phase, const std::string &counter, const std::function<int()> &pass)
+{
+    PhaseTimer timer(statistics, phase);
+    int count = pass();
+    statistics.counters[counter] += count;
+    return count;
+}
+
+// Create a Context. This can be used to pass around information about
+// what's currently being compiled (e.g. function scope and variable names).
+Context MakeContext(CommandLineArguments &args, Profile &profile)
+{
+    Context ctx;
+    ctx.setUnrollFactor(args.unroll_factor);
+    ctx.setFunctionSections(args.function_sections);
+    ctx.setCodegenThreads(args.codegen_threads);
+    if (args.profile_use)
+    {
+        if (ReadProfile(ProfilePath(args), profile))
+        {
+            for (auto &function : profile.blockCounts)
+            {
+                ctx.setFunctionCount(function.first, function.second.front());
+            }
+        }
+        else
+        {
+            PrintLine(std::cerr, "Warning: no profile at " + ProfilePath(args));
+        }
+    }
+    return ctx;
+}
+
+// Clean up the emitted code before writing it out. Each pass can expose
+// more work for the other, so they run until neither changes anything.
+void RunAssemblyPasses(std::vector<AssemblyLine> &code, CommandLineArguments &args, CompilationStatistics &statistics, Context &ctx, const Profile &profile)
+{
+    int branches = CountBranches(code);
+    int rewrites;
+    do
+    {
+        rewrites = 0;
+        if (args.peephole)
+        {
+            rewrites += RunPass(statistics, "peephole", "peephole rewrites", [&] { return RunPeephole(code); });
+        }
+        if (args.copy_propagation)
+        {
+            rewrites += RunPass(statistics, "copy propagation", "copy propagation rewrites", [&] { return RunCopyPropagation(code); });
+        }
+        if (args.jump_threading)
+        {
+            rewrites += RunPass(statistics, "jump threading", "jump threading rewrites", [&] { return RunJumpThreading(code); });
+        }
+    } while (rewrites > 0);
+    ctx.countStatistic("removed branches", std::max(0, branches - CountBranches(code)));
+    // Blocks are counted and placed once the branches between them are
+    // settled, so a profiled build numbers them the same way as the build
+    // using the profile
+    if (args.profile_generate)
+    {
+        RunPass(statistics, "profile instrumentation", "profile counters", [&] { return RunProfileInstrumentation(code, ProfilePath(args)); });
+    }
+    if (args.reorder_blocks)
+    {
+        RunPass(statistics, "block layout", "blocks moved", [&] { return RunBlockLayout(code, args.profile_use ? &profile : nullptr); });
+    }
+    // Scheduling comes last, since the passes above look for instructions
+    // next to each other
+    if (args.schedule)
+    {
+        RunPass(statistics, "scheduling", "instructions scheduled", [&] { return RunScheduler(code, *FindPipelineModel(args.tune)); });
+    }
 }
 
 // Compile from the root of the AST and output this to the
 // args.compiledOutputPath file.
-void Compile(Node *root, CommandLineArguments &args)
+void Compile(Node *root, CommandLineArguments &args, CompilationStatistics &statistics)
 {
-    // Create a Context. This can be used to pass around information about
-    // what's currently being compiled (e.g. function scope and variable names).
-    Context ctx;
+    Profile profile;
+    Context ctx = MakeContext(args, profile);
+
+    PrintLine(std::cout, "Compiling parsed AST...");
+    std::stringstream assembly;
+    {
+        // Registers are allocated as the AST is walked, so this phase
+        // includes register allocation
+        PhaseTimer timer(statistics, "code generation");
+        assembly << ".text" << std::endl;
+        root->EmitRISC(assembly, ctx, 10);  // Output to register a0 (register with index 10)
+    }
+    std::vector<AssemblyLine> code;
+    {
+        PhaseTimer timer(statistics, "assembly parsing");
+        code = ParseAssembly(assembly);
+    }
+    RunAssemblyPasses(code, args, statistics, ctx, profile);
+
+    {
+        PhaseTimer timer(statistics, "emission");
+        std::ofstream output(args.compile_output_path, std::ios::trunc);
+        WriteAssembly(output, code);
+        output.close();
+    }
+    for (auto &counter : ctx.getStatistics())
+    {
+        statistics.counters[counter.first] += counter.second;
+    }
+    statistics.countOpcodes(code);
+    PrintLine(std::cout, "Compiled to: " + args.compile_output_path);
+}
+
+// The passes name the labels they make, such as LJ<n>, after the labels of
+// the code they are given, so code passed to them a function at a time gets
+// the same names again. They are numbered on through the file instead.
+void RenumberPassLabels(std::vector<AssemblyLine> &code, int &labels)
+{
+    std::map<std::string, std::string> names;
+    for (auto &line : code)
+    {
+        if (line.isLabel() && IsLocalLabel(line.label) && isupper((unsigned char)line.label[1]))
+        {
+            size_t digits = line.label.find_first_of("0123456789");
+            names[line.label] = line.label.substr(0, digits) + std::to_string(++labels);
+        }
+    }
+    for (auto &line : code)
+    {
+        auto name = names.find(line.isLabel() ? line.label : line.target());
+        if (name == names.end())
+        {
+            continue;
+        }
+        if (line.isLabel())
+        {
+            line.label = name->second;
+        }
+        else
+        {
+            line.setTarget(name->second);
+        }
+    }
+}
 
-    std::cout << "Compiling parsed AST..." << std::endl;
+// Declarations on their way from the parser to the backend thread. The
+// parser waits while the backend is a full queue behind, so only so many
+// ASTs are alive at once.
+class DeclarationQueue
+{
+public:
+    static const size_t capacity = 64;
+
+    void push(Node *declaration)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&] { return declarations.size() < capacity; });
+        declarations.push_back(declaration);
+        notEmpty.notify_one();
+    }
+    // No more declarations will come
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_one();
+    }
+    // Returns false once the queue is closed and empty
+    bool pop(Node *&declaration)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return !declarations.empty() || closed; });
+        if (declarations.empty())
+        {
+            return false;
+        }
+        declaration = declarations.front();
+        declarations.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable notFull, notEmpty;
+    std::deque<Node *> declarations;
+    bool closed = false;
+};
+
+// Print and compile each top-level declaration as soon as the parser has
+// it, then free it, so memory does not grow with the size of the file: only
+// what the Context knows about the functions is kept. Returns the exit
+// status for the file.
+int CompileStreaming(CommandLineArguments &args, CompilationStatistics &statistics)
+{
+    Profile profile;
+    Context ctx = MakeContext(args, profile);
+    // The backend measures into statistics of its own, as it may run on
+    // another thread than the parser
+    CompilationStatistics backendStatistics;
+    backendStatistics.timing = statistics.timing;
+    std::string printed_path = args.compile_output_path + ".printed";
+    std::ofstream printed(printed_path, std::ios::trunc);
     std::ofstream output(args.compile_output_path, std::ios::trunc);
-    output << ".text" << std::endl;
-    root->EmitRISC(output, ctx, 10);  // Output to register a0 (register with index 10)
+    int labels = 0;
+    bool first = true;
+    auto backend = [&](Node *declaration)
+    {
+        {
+            PhaseTimer timer(backendStatistics, "printing");
+            declaration->Print(printed);
+        }
+        std::stringstream assembly;
+        {
+            PhaseTimer timer(backendStatistics, "code generation");
+            assembly << (first ? ".text\n" : "");
+            TranslationUnit::EmitStreamed(assembly, ctx, declaration, 10);
+            first = false;
+        }
+        delete declaration;
+        std::vector<AssemblyLine> code;
+        {
+            PhaseTimer timer(backendStatistics, "assembly parsing");
+            code = ParseAssembly(assembly);
+        }
+        RunAssemblyPasses(code, args, backendStatistics, ctx, profile);
+        RenumberPassLabels(code, labels);
+        {
+            PhaseTimer timer(backendStatistics, "emission");
+            WriteAssembly(output, code);
+        }
+        backendStatistics.countOpcodes(code);
+    };
+
+    // With a thread to spare, the backend runs on it while parsing goes on.
+    // It takes the declarations in the order they were parsed, with the
+    // same Context, so the output is the same as without it.
+    ParserState parsed;
+    if (args.codegen_threads > 1)
+    {
+        DeclarationQueue queue;
+        std::thread worker([&]
+        {
+            Node *declaration;
+            while (queue.pop(declaration))
+            {
+                backend(declaration);
+            }
+        });
+        parsed = Parse(args, statistics, [&](Node *declaration) { queue.push(declaration); });
+        queue.close();
+        worker.join();
+    }
+    else
+    {
+        parsed = Parse(args, statistics, backend);
+    }
+    statistics.add(backendStatistics);
+    printed.close();
     output.close();
-    std::cout << "Compiled to: " << args.compile_output_path << std::endl;
+    delete parsed.root;
+    if (!parsed.error.empty())
+    {
+        // As without streaming, a file that does not parse leaves no output
+        PrintLine(std::cerr, parsed.error);
+        std::filesystem::remove(printed_path);
+        std::filesystem::remove(args.compile_output_path);
+        return 1;
+    }
+    for (auto &counter : ctx.getStatistics())
+    {
+        statistics.counters[counter.first] += counter.second;
+    }
+    PrintLine(std::cout, "Printed parsed AST to: " + printed_path);
+    PrintLine(std::cout, "Compiled to: " + args.compile_output_path);
+    return 0;
 }
 
-int main(int argc, char **argv)
+// Print the reports asked for on the command line, one per file
+void Report(const CommandLineArguments &args, const std::vector<CompilationStatistics> &statistics)
 {
-    // Parse CLI arguments to fetch the source file to compile and the path to output to.
-    // This retrives [source-file.c] and [dest-file.s], when the compiler is invoked as follows:
-    // ./bin/c_compiler -S [source-file.c] -o [dest-file.s]
-    auto command_line_arguments = ParseCommandLineArgs(argc, argv);
+    bool batch = args.files.size() > 1;
+    for (size_t i = 0; i < args.files.size(); i++)
+    {
+        if (batch && (args.time_report || args.stats))
+        {
+            std::cerr << "Report for " << args.files[i].source_path << ":" << std::endl;
+        }
+        if (args.time_report)
+        {
+            WriteTimeReport(std::cerr, statistics[i]);
+        }
+        if (args.stats)
+        {
+            WriteStatistics(std::cerr, statistics[i]);
+        }
+    }
+    if (!args.stats_json_path.empty())
+    {
+        // An object for a single file, as before there were batches, and an
+        // array of them otherwise
+        std::ofstream output(args.stats_json_path, std::ios::trunc);
+        output << (batch ? "[" : "");
+        for (size_t i = 0; i < args.files.size(); i++)
+        {
+            output << (i == 0 ? "" : ",");
+            WriteStatisticsJson(output, statistics[i], args.files[i].source_path);
+        }
+        output << (batch ? "]\n" : "");
+    }
+}
+
+// Parse, print and compile one file, with an AST and a Context of its own.
+// Returns the exit status for it.
+int CompileFile(CommandLineArguments args, const SourceFile &file, CompilationStatistics &statistics)
+{
+    args.compile_source_path = file.source_path;
+    args.compile_output_path = file.output_path;
+    // Phases are only timed when a report needs it
+    statistics.timing = args.time_report || !args.stats_json_path.empty();
+    if (args.streaming)
+    {
+        return CompileStreaming(args, statistics);
+    }
 
     // Parse input and generate AST
-    auto ast_root = Parse(command_line_arguments);
+    ParserState parsed = Parse(args, statistics);
+    if (!parsed.error.empty())
+    {
+        PrintLine(std::cerr, parsed.error);
+        delete parsed.root;
+        return 1;
+    }
+    auto ast_root = parsed.root;
     if (ast_root == nullptr)
     {
         // Check something was actually returned by parseAST().
-        std::cerr << "The root of the AST was a null pointer. Likely the root was never initialised correctly during parsing." << std::endl;
+        PrintLine(std::cerr, "The root of the AST was a null pointer. Likely the root was never initialised correctly during parsing.");
         return 3;
     }
 
-    PrettyPrint(ast_root, command_line_arguments);
-    Compile(ast_root, command_line_arguments);
+    PrettyPrint(ast_root, args, statistics);
+    Compile(ast_root, args, statistics);
 
     // Clean up afterwards.
     delete ast_root;
     return 0;
 }
+
+// Compile every file on a pool of worker threads, each taking the next file
+// nobody has started on. Returns the exit status of the first file that
+// failed, or 0.
+int CompileFiles(const CommandLineArguments &args)
+{
+    size_t files = args.files.size();
+    std::vector<int> statuses(files, 0);
+    std::vector<CompilationStatistics> statistics(files);
+    size_t threads = args.jobs > 0 ? args.jobs : std::max(1u, std::thread::hardware_concurrency());
+    // Threads left over when there are fewer files than jobs compile the
+    // functions of each file in parallel
+    CommandLineArguments fileArgs = args;
+    fileArgs.codegen_threads = std::max<size_t>(1, threads / std::max<size_t>(1, std::min(threads, files)));
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < files; i = next++)
+        {
+            statuses[i] = CompileFile(fileArgs, args.files[i], statistics[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t k = 1; k < std::min(threads, files); k++)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : pool)
+    {
+        thread.join();
+    }
+
+    Report(args, statistics);
+    for (int status : statuses)
+    {
+        if (status != 0)
+        {
+            return status;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    // Parse CLI arguments to fetch the source file to compile and the path to output to.
+    // This retrives [source-file.c] and [dest-file.s], when the compiler is invoked as follows:
+    // ./bin/c_compiler -S [source-file.c] -o [dest-file.s]
+    // or several of each, or a manifest of files, to compile them in one go
+    auto command_line_arguments = ParseCommandLineArgs(argc, argv);
+    return CompileFiles(command_line_arguments);
+}
@@ -0,0 +1,98 @@
+#include <copy_propagation.h>
+
+#include <peephole.h>
+
+namespace
+{
+    // mv x, y; ...; op z, x  ->  mv x, y; ...; op z, y
+    // Uses of x are replaced until x or y is written again. The move itself
+    // goes once nothing reads x any more.
+    bool PropagateForward(std::vector<AssemblyLine> &code, size_t i)
+    {
+        const std::string copy = code[i].operands[0];
+        const std::string source = code[i].operands[1];
+        if (copy == source || copy == "zero")
+        {
+            return false;
+        }
+        bool changed = false;
+        for (size_t next = i + 1; next < code.size() && code[next].isInstruction(); next++)
+        {
+            AssemblyLine &line = code[next];
+            // Calls and returns read argument and result registers implicitly
+            if (line.isCall() || line.isReturn())
+            {
+                break;
+            }
+            if (line.uses(copy))
+            {
+                line.replaceUses(copy, source);
+                changed = true;
+            }
+            if (line.endsBlock() || line.definedRegister() == copy || line.definedRegister() == source)
+            {
+                break;
+            }
+        }
+        if (IsDeadAfter(code, i, copy))
+        {
+            code.erase(code.begin() + i);
+            return true;
+        }
+        return changed;
+    }
+
+    // op t, a, b; ...; mv x, t  ->  op x, a, b; ...
+    // The producer writes the destination directly when t is not needed
+    // after the move and nothing in between touches x.
+    bool CoalesceBackward(std::vector<AssemblyLine> &code, size_t i)
+    {
+        const std::string copy = code[i].operands[0];
+        const std::string source = code[i].operands[1];
+        if (copy == source || copy == "zero" || source == "zero" || !IsDeadAfter(code, i, source))
+        {
+            return false;
+        }
+        for (size_t previous = i; previous-- > 0;)
+        {
+            AssemblyLine &line = code[previous];
+            if (!line.isInstruction() || line.endsBlock())
+            {
+                return false;
+            }
+            // The producer may itself read x, since it does so before writing
+            if (line.definedRegister() == source)
+            {
+                line.setDefinedRegister(copy);
+                for (size_t between = previous + 1; between < i; between++)
+                {
+                    code[between].replaceUses(source, copy);
+                }
+                code.erase(code.begin() + i);
+                return true;
+            }
+            if (line.uses(copy) || line.definedRegister() == copy)
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+}
+
+int RunCopyPropagation(std::vector<AssemblyLine> &code)
+{
+    int rewrites = 0;
+    for (size_t i = 0; i < code.size(); i++)
+    {
+        if (!code[i].isMove())
+        {
+            continue;
+        }
+        if (CoalesceBackward(code, i) || PropagateForward(code, i))
+        {
+            rewrites++;
+        }
+    }
+    return rewrites;
+}
@@ -0,0 +1,354 @@
+#include <jump_threading.h>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+namespace
+{
+    // Instructions copied onto an edge to take it past a decided branch
+    const size_t maxThreadedInstructions = 4;
+
+    // Where each label is, and which labels something branches or jumps to
+    struct LabelIndex
+    {
+        std::map<std::string, size_t> positions;
+        std::set<std::string> referenced;
+    };
+
+    LabelIndex IndexLabels(const std::vector<AssemblyLine> &code)
+    {
+        LabelIndex index;
+        for (size_t i = 0; i < code.size(); i++)
+        {
+            if (code[i].isLabel())
+            {
+                index.positions[code[i].label] = i;
+            }
+            else if (!code[i].target().empty())
+            {
+                index.referenced.insert(code[i].target());
+            }
+        }
+        return index;
+    }
+
+    // Numbered on from the number of labels there are, so the names only
+    // depend on this file
+    std::string NewLabel(const LabelIndex &index)
+    {
+        size_t labels = index.positions.size();
+        std::string label;
+        do
+        {
+            label = "LJ" + std::to_string(++labels);
+        } while (index.positions.count(label));
+        return label;
+    }
+
+    bool ParseConstant(const std::string &operand, long long &value)
+    {
+        try
+        {
+            size_t parsed;
+            value = std::stoll(operand, &parsed, 0);
+            return parsed == operand.size();
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    // `beq reg, zero` or `beqz reg` for "beq", and the same for "bne"
+    bool TestsZero(const AssemblyLine &line, const std::string &opcode, std::string &reg)
+    {
+        if (line.opcode == opcode + "z" && line.operands.size() == 2)
+        {
+            reg = line.operands[0];
+            return true;
+        }
+        if (line.opcode == opcode && line.operands.size() == 3 && (line.operands[0] == "zero") != (line.operands[1] == "zero"))
+        {
+            reg = line.operands[0] == "zero" ? line.operands[1] : line.operands[0];
+            return true;
+        }
+        return false;
+    }
+
+    // Values registers are known to hold at position end, looking back
+    // through its block: set by li, or zero after falling through a test for
+    // not zero
+    std::map<std::string, long long> KnownValues(const std::vector<AssemblyLine> &code, size_t end)
+    {
+        std::map<std::string, long long> known;
+        std::set<std::string> written;
+        for (size_t i = end; i-- > 0;)
+        {
+            const AssemblyLine &line = code[i];
+            if (!line.isInstruction() || line.isCall() || line.isJump() || line.isReturn())
+            {
+                break;
+            }
+            std::string reg;
+            if (line.isConditionalBranch())
+            {
+                if (TestsZero(line, "bne", reg) && written.insert(reg).second)
+                {
+                    known[reg] = 0;
+                }
+                continue;
+            }
+            reg = line.definedRegister();
+            long long value;
+            if (reg.empty() || !written.insert(reg).second)
+            {
+                continue;
+            }
+            if (line.opcode == "li" && line.operands.size() == 2 && ParseConstant(line.operands[1], value))
+            {
+                known[reg] = value;
+            }
+        }
+        return known;
+    }
+
+    // Whether the branch goes to its target, given the values of its operands
+    bool DecideBranch(const AssemblyLine &branch, const std::map<std::string, long long> &known, bool &taken)
+    {
+        std::vector<int32_t> values;
+        for (size_t k = 0; k + 1 < branch.operands.size(); k++)
+        {
+            const std::string &reg = branch.operands[k];
+            auto value = known.find(reg);
+            if (reg == "zero")
+            {
+                values.push_back(0);
+            }
+            else if (value != known.end())
+            {
+                values.push_back((int32_t)value->second);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        int32_t a = values[0];
+        int32_t b = values.size() > 1 ? values[1] : 0;
+        std::string opcode = branch.opcode;
+        if (opcode.back() == 'z')
+        {
+            opcode.pop_back();
+        }
+        static const std::map<std::string, bool (*)(int32_t, int32_t)> comparisons = {
+            {"beq", [](int32_t x, int32_t y) { return x == y; }},
+            {"bne", [](int32_t x, int32_t y) { return x != y; }},
+            {"blt", [](int32_t x, int32_t y) { return x < y; }},
+            {"bge", [](int32_t x, int32_t y) { return x >= y; }},
+            {"bgt", [](int32_t x, int32_t y) { return x > y; }},
+            {"ble", [](int32_t x, int32_t y) { return x <= y; }},
+            {"bltu", [](int32_t x, int32_t y) { return (uint32_t)x < (uint32_t)y; }},
+            {"bgeu", [](int32_t x, int32_t y) { return (uint32_t)x >= (uint32_t)y; }},
+        };
+        auto comparison = comparisons.find(opcode);
+        if (comparison == comparisons.end())
+        {
+            return false;
+        }
+        taken = comparison->second(a, b);
+        return true;
+    }
+
+    // The block at label, if it is a few instructions and then a conditional
+    // branch on registers those instructions do not write. Returns the
+    // position of the branch, or 0.
+    size_t FindDecidingBranch(const std::vector<AssemblyLine> &code, size_t label, size_t &start)
+    {
+        start = label;
+        while (start < code.size() && code[start].isLabel())
+        {
+            start++;
+        }
+        size_t branch = start;
+        while (branch < code.size() && code[branch].isInstruction() && !code[branch].endsBlock())
+        {
+            branch++;
+        }
+        if (branch >= code.size() || !code[branch].isConditionalBranch() || branch - start > maxThreadedInstructions)
+        {
+            return 0;
+        }
+        std::vector<std::string> tested = code[branch].usedRegisters();
+        for (size_t i = start; i < branch; i++)
+        {
+            for (auto &reg : tested)
+            {
+                if (code[i].definedRegister() == reg)
+                {
+                    return 0;
+                }
+            }
+        }
+        return branch;
+    }
+
+    // Label the decided branch leads to, adding one after it if it falls
+    // through to an unlabelled instruction. position is moved if the label
+    // goes in before it.
+    std::string DecidedTarget(std::vector<AssemblyLine> &code, const LabelIndex &index, size_t branch, bool taken, size_t &position)
+    {
+        if (taken)
+        {
+            return code[branch].target();
+        }
+        if (branch + 1 < code.size() && code[branch + 1].isLabel())
+        {
+            return code[branch + 1].label;
+        }
+        AssemblyLine label;
+        label.label = NewLabel(index);
+        code.insert(code.begin() + branch + 1, label);
+        if (position > branch)
+        {
+            position++;
+        }
+        return label.label;
+    }
+
+    // Final label of a chain of jumps starting at label
+    std::string FollowJumps(const std::vector<AssemblyLine> &code, const LabelIndex &index, std::string label)
+    {
+        std::set<std::string> visited;
+        while (visited.insert(label).second)
+        {
+            auto position = index.positions.find(label);
+            if (position == index.positions.end())
+            {
+                break;
+            }
+            size_t next = position->second;
+            while (next < code.size() && code[next].isLabel())
+            {
+                next++;
+            }
+            if (next >= code.size() || code[next].opcode != "j" || visited.count(code[next].target()))
+            {
+                break;
+            }
+            label = code[next].target();
+        }
+        return label;
+    }
+
+    // j L1 ... L1: j L2  ->  j L2
+    // li t0, 0; j L1 ... L1: beq t0, zero, L2  ->  li t0, 0; j L2
+    bool ThreadEdge(std::vector<AssemblyLine> &code, const LabelIndex &index, size_t i)
+    {
+        AssemblyLine &line = code[i];
+        if (line.opcode != "j" && !line.isConditionalBranch())
+        {
+            return false;
+        }
+        std::string target = line.target();
+        std::string final = FollowJumps(code, index, target);
+        if (final != target)
+        {
+            line.setTarget(final);
+            return true;
+        }
+
+        auto position = index.positions.find(target);
+        size_t start;
+        size_t branch = position == index.positions.end() ? 0 : FindDecidingBranch(code, position->second, start);
+        if (branch == 0 || (line.isConditionalBranch() && branch != start))
+        {
+            return false;
+        }
+        std::map<std::string, long long> known = KnownValues(code, i);
+        std::string reg;
+        if (TestsZero(line, "beq", reg))
+        {
+            known[reg] = 0;
+        }
+        bool taken;
+        if (!DecideBranch(code[branch], known, taken))
+        {
+            return false;
+        }
+        std::string destination = DecidedTarget(code, index, branch, taken, i);
+        if (destination == target)
+        {
+            return false;
+        }
+        if (code[i].isConditionalBranch())
+        {
+            code[i].setTarget(destination);
+            return true;
+        }
+        std::vector<AssemblyLine> copy(code.begin() + start, code.begin() + branch);
+        copy.push_back(MakeInstruction("j", {destination}));
+        code.erase(code.begin() + i);
+        code.insert(code.begin() + i, copy.begin(), copy.end());
+        return true;
+    }
+
+    // li t0, 1; L1: beq t0, zero, L2  ->  li t0, 1; j L3; L1: beq t0, zero, L2; L3:
+    bool ThreadFallthrough(std::vector<AssemblyLine> &code, const LabelIndex &index, size_t i)
+    {
+        if (!code[i].isLabel() || i == 0 || !code[i - 1].isInstruction() || code[i - 1].isJump() || code[i - 1].isReturn())
+        {
+            return false;
+        }
+        size_t start;
+        size_t branch = FindDecidingBranch(code, i, start);
+        bool taken;
+        if (branch == 0 || !DecideBranch(code[branch], KnownValues(code, i), taken))
+        {
+            return false;
+        }
+        std::vector<AssemblyLine> copy(code.begin() + start, code.begin() + branch);
+        copy.push_back(MakeInstruction("j", {DecidedTarget(code, index, branch, taken, i)}));
+        code.insert(code.begin() + i, copy.begin(), copy.end());
+        return true;
+    }
+
+    // Instructions after a jump or return that no label leads to, and
+    // labels nothing refers to
+    bool RemoveUnreachable(std::vector<AssemblyLine> &code, const LabelIndex &index, size_t i)
+    {
+        if (code[i].isLabel() && IsLocalLabel(code[i].label) && !index.referenced.count(code[i].label))
+        {
+            code.erase(code.begin() + i);
+            return true;
+        }
+        if ((code[i].isJump() || code[i].isReturn()) && i + 1 < code.size() && code[i + 1].isInstruction())
+        {
+            code.erase(code.begin() + i + 1);
+            return true;
+        }
+        return false;
+    }
+}
+
+int RunJumpThreading(std::vector<AssemblyLine> &code)
+{
+    int rewrites = 0;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        LabelIndex index = IndexLabels(code);
+        for (size_t i = 0; i < code.size(); i++)
+        {
+            if (ThreadEdge(code, index, i) || ThreadFallthrough(code, index, i) || RemoveUnreachable(code, index, i))
+            {
+                rewrites++;
+                changed = true;
+                index = IndexLabels(code);
+            }
+        }
+    }
+    return rewrites;
+}
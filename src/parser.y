@@ -4,12 +4,58 @@
     #include "ast.hpp"
     #include <memory>
 
-    extern Node *g_root;
-    extern FILE *yyin;
-    int yylex(void);
-    void yyerror(const char *);
+    // The scanner flex makes with %option reentrant
+    typedef void *yyscan_t;
 }
 
+%code provides{
+    int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner);
+    void yyerror(yyscan_t scanner, ParserState *state, const char *message);
+}
+
+%code{
+    #include "statistics.h"
+
+    int yylex_init_extra(ParserState *extra, yyscan_t *scanner);
+    ParserState *yyget_extra(yyscan_t scanner);
+    void yyset_in(FILE *file, yyscan_t scanner);
+    int yylex_destroy(yyscan_t scanner);
+
+    // Lexing happens as the parser asks for each token, so its cost is
+    // measured around every call, for -ftime-report
+    static int TimedLex(YYSTYPE *value, yyscan_t scanner)
+    {
+        PhaseTiming *lexing = yyget_extra(scanner)->lexing;
+        if (lexing == nullptr)
+        {
+            return yylex(value, scanner);
+        }
+        ResourceSnapshot start = TakeSnapshot();
+        int token = yylex(value, scanner);
+        lexing->add(start, TakeSnapshot());
+        return token;
+    }
+    #define yylex TimedLex
+
+    // Returns the declaration to add to the translation unit, or nullptr if
+    // it went straight to the backend
+    static Node *TakeDeclaration(ParserState *state, Node *declaration)
+    {
+        if (!state->declaration)
+        {
+            return declaration;
+        }
+        state->declaration(declaration);
+        return nullptr;
+    }
+}
+
+// Each parse has a parser and a scanner of its own, and puts what it
+// finds in state, so files can be parsed on several threads at once
+%define api.pure full
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {ParserState *state}
+
 // Represents the value associated with any kind of AST node.
 %union{
   Node         *node;
@@ -25,7 +71,7 @@
 %token MUL_ASSIGN DIV_ASSIGN MOD_ASSIGN ADD_ASSIGN SUB_ASSIGN LEFT_ASSIGN RIGHT_ASSIGN AND_ASSIGN XOR_ASSIGN OR_ASSIGN
 %token TYPE_NAME TYPEDEF EXTERN STATIC AUTO REGISTER SIZEOF
 %token CHAR SHORT INT LONG SIGNED UNSIGNED FLOAT DOUBLE CONST VOLATILE VOID
-%token STRUCT UNION ENUM ELLIPSIS
+%token STRUCT UNION ENUM ELLIPSIS ATTRIBUTE
 %token CASE DEFAULT IF ELSE SWITCH WHILE DO FOR GOTO CONTINUE BREAK RETURN
 
 %type <node> translation_unit function_definition primary_expression postfix_expression
@@ -39,18 +85,21 @@
 
 %type <nodes> statement_list external_declaration argument_expression_list init_declarator_list declaration_list
 
-%type <string> unary_operator assignment_operator storage_class_specifier
+%type <string> unary_operator assignment_operator storage_class_specifier attribute_specifier
 
 %type <number_int> INT_CONSTANT STRING_LITERAL
 %type <number_float> FLOAT_CONSTANT
 %type <string> IDENTIFIER
 
+// Values a syntax error leaves on the stack
+%destructor { delete $$; } <node> <nodes> <string>
+
 
 %start ROOT
 %%
 
 ROOT
-  : translation_unit { g_root = $1; }
+  : translation_unit { state->root = new TranslationUnit($1); }
 
 translation_unit
 	: external_declaration { $$ = $1; }
@@ -58,8 +107,14 @@ translation_unit
 	;
 
 external_declaration
-	: function_definition { $$ = new NodeList($1); }
-	| external_declaration function_definition { $1->PushBack($2); $$=$1; }
+	: function_definition { $$ = new NodeList(TakeDeclaration(state, $1)); }
+	| external_declaration function_definition {
+		Node *declaration = TakeDeclaration(state, $2);
+		if (declaration != nullptr){
+			$1->PushBack(declaration);
+		}
+		$$=$1;
+	}
 	| declaration
 	;
 
@@ -71,6 +126,19 @@ function_definition
 	| declarator declaration_list compound_statement
 	| declarator compound_statement
 	| declaration_specifiers declarator ';' { $$ = new EmptyFunctionDefinition($1, $2); }
+	| declaration_specifiers declarator attribute_specifier ';' {
+		$$ = new EmptyFunctionDefinition($1, $2, *$3);
+		delete $3;
+	}
+	| attribute_specifier declaration_specifiers declarator ';' {
+		$$ = new EmptyFunctionDefinition($2, $3, *$1);
+		delete $1;
+	}
+	;
+
+attribute_specifier
+	: ATTRIBUTE '(' '(' IDENTIFIER ')' ')' { $$ = $4; }
+	| ATTRIBUTE '(' '(' CONST ')' ')' { $$ = new std::string("const"); }
 	;
 
 
@@ -93,13 +161,13 @@ primary_expression
 
 postfix_expression
 	: primary_expression { $$ = $1; }
-	| postfix_expression '[' expression ']'
+	| postfix_expression '[' expression ']' { $$ = new ArrayIndex($1, $3); }
 	| postfix_expression '(' ')' { $$ = new FunctionCall($1); }
 	| postfix_expression '(' argument_expression_list ')' { $$ = new FunctionCallWithArguments($1, $3); }
 	| postfix_expression '.' IDENTIFIER
 	| postfix_expression PTR_OP IDENTIFIER
-	| postfix_expression INC_OP
-	| postfix_expression DEC_OP
+	| postfix_expression INC_OP { $$ = new IncrementExpression($1, 1, false); }
+	| postfix_expression DEC_OP { $$ = new IncrementExpression($1, -1, false); }
 	;
 
 argument_expression_list
@@ -109,8 +177,8 @@ argument_expression_list
 
 unary_expression
 	: postfix_expression { $$ = $1; }
-	| INC_OP unary_expression
-	| DEC_OP unary_expression
+	| INC_OP unary_expression { $$ = new IncrementExpression($2, 1, true); }
+	| DEC_OP unary_expression { $$ = new IncrementExpression($2, -1, true); }
 	| unary_operator cast_expression
 	| SIZEOF unary_expression { $$ = new SizeOfVariable($2); }
 	| SIZEOF '(' type_name ')' { $$ = new SizeOfType($3); }
@@ -238,8 +306,14 @@ declaration
 	;
 
 declaration_specifiers
-	: storage_class_specifier
-	| storage_class_specifier declaration_specifiers
+	: storage_class_specifier {
+		$$ = new StorageClassSpecifier(*$1, new TypeSpecifier("int"));
+		delete $1;
+	}
+	| storage_class_specifier declaration_specifiers {
+		$$ = new StorageClassSpecifier(*$1, $2);
+		delete $1;
+	}
 	| type_specifier { $$ = $1; }
 	| type_specifier declaration_specifiers
 	;
@@ -257,11 +331,11 @@ init_declarator
 	;
 
 storage_class_specifier
-	: TYPEDEF
-	| EXTERN
-	| STATIC
-	| AUTO
-	| REGISTER
+	: TYPEDEF { $$ = new std::string("typedef"); }
+	| EXTERN { $$ = new std::string("extern"); }
+	| STATIC { $$ = new std::string("static"); }
+	| AUTO { $$ = new std::string("auto"); }
+	| REGISTER { $$ = new std::string("register"); }
 	;
 
 type_specifier
@@ -355,8 +429,8 @@ direct_declarator
         delete $1;
 	}
 	| '(' declarator ')'
-	| direct_declarator '[' constant_expression ']' //array declarator
-	| direct_declarator '[' ']'
+	| direct_declarator '[' constant_expression ']' { $$ = new ArrayDeclarator($1, $3); }
+	| direct_declarator '[' ']' { $$ = new ArrayDeclarator($1, nullptr); }
 	| direct_declarator '(' parameter_list ')' { $$ = new FunctionWithParamDefinition($1,$3); }
 	| direct_declarator '(' identifier_list ')'
 	| direct_declarator '(' ')' {
@@ -439,13 +513,14 @@ compound_statement
 		$$ = nullptr;
 	}
 	| '{' statement_list '}' {
-		$$ = $2;
+		$$ = new CompoundStatement($2);
 	}
 	| '{' declaration_list '}' {
-		$$ = $2;
+		$$ = new CompoundStatement($2);
 	}
 	| '{' declaration_list statement_list '}'  {
-		$$ = $3; // may need to implement multiline here
+		$2->PushBack($3);
+		$$ = new CompoundStatement($2);
 	}
 	;
 
@@ -493,16 +568,28 @@ jump_statement
 
 %%
 
-Node *g_root;
+void yyerror(yyscan_t scanner, ParserState *state, const char *message)
+{
+  if(state->error.empty()){
+    state->error = std::string("Lexing error: ") + message;
+  }
+}
 
-Node *ParseAST(std::string file_name)
+ParserState ParseAST(std::string file_name, PhaseTiming *lexing, std::function<void(Node *)> declaration)
 {
-  yyin = fopen(file_name.c_str(), "r");
-  if(yyin == NULL){
-    std::cerr << "Couldn't open input file: " << file_name << std::endl;
-    exit(1);
+  ParserState state;
+  state.lexing = lexing;
+  state.declaration = declaration;
+  FILE *file = fopen(file_name.c_str(), "r");
+  if(file == NULL){
+    state.error = "Couldn't open input file: " + file_name;
+    return state;
   }
-  g_root = nullptr;
-  yyparse();
-  return g_root;
+  yyscan_t scanner;
+  yylex_init_extra(&state, &scanner);
+  yyset_in(file, scanner);
+  yyparse(scanner, &state);
+  yylex_destroy(scanner);
+  fclose(file);
+  return state;
 }
@@ -0,0 +1,371 @@
+#include <peephole.h>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+namespace
+{
+    bool IsImmediate(const std::string &operand, int &value)
+    {
+        if (operand.empty() || IsRegister(operand))
+        {
+            return false;
+        }
+        try
+        {
+            size_t parsed;
+            long long number = std::stoll(operand, &parsed, 0);
+            if (parsed != operand.size() || number < INT32_MIN || number > INT32_MAX)
+            {
+                return false;
+            }
+            value = (int)number;
+            return true;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    bool FitsImmediate(int value)
+    {
+        return value >= -2048 && value <= 2047;
+    }
+
+    // Whether code[i+1] is the next instruction in the same basic block
+    bool FollowedInBlock(const std::vector<AssemblyLine> &code, size_t i)
+    {
+        return i + 1 < code.size() && code[i].isInstruction() && !code[i].endsBlock() && code[i + 1].isInstruction();
+    }
+
+    // Registers whose value is still needed after a return
+    bool LiveOnReturn(const std::string &reg)
+    {
+        static const std::set<std::string> live = {"a0", "a1", "fa0", "fa1", "sp", "ra", "gp", "tp", "s0", "fp"};
+        return live.count(reg) || (reg.size() > 1 && reg[0] == 's') || (reg.size() > 2 && reg[0] == 'f' && reg[1] == 's');
+    }
+
+    // Argument registers, which a call reads
+    bool IsArgumentRegister(const std::string &reg)
+    {
+        std::string name = reg[0] == 'f' ? reg.substr(1) : reg;
+        return name.size() == 2 && name[0] == 'a' && name[1] >= '0' && name[1] <= '7';
+    }
+
+    bool IsDeadFrom(const std::vector<AssemblyLine> &code, size_t start, const std::string &reg, std::set<std::string> &visited);
+
+    // Whether reg is dead on entry to the block at label
+    bool IsDeadAtLabel(const std::vector<AssemblyLine> &code, const std::string &label, const std::string &reg, std::set<std::string> &visited)
+    {
+        // A path that comes back round without reading reg does not keep it live
+        if (!visited.insert(label).second)
+        {
+            return true;
+        }
+        for (size_t i = 0; i < code.size(); i++)
+        {
+            if (code[i].label == label)
+            {
+                return IsDeadFrom(code, i + 1, reg, visited);
+            }
+        }
+        return false;
+    }
+
+    // Whether every path from position start overwrites reg, or leaves the
+    // function, before reading it
+    bool IsDeadFrom(const std::vector<AssemblyLine> &code, size_t start, const std::string &reg, std::set<std::string> &visited)
+    {
+        for (size_t next = start; next < code.size(); next++)
+        {
+            const AssemblyLine &line = code[next];
+            if (line.isLabel())
+            {
+                continue;
+            }
+            if (line.isDirective() || line.uses(reg))
+            {
+                return false;
+            }
+            if (line.isReturn())
+            {
+                return !LiveOnReturn(reg);
+            }
+            // A callee known not to clobber a register leaves its value for
+            // the code after the call, so a call only ends the search if it
+            // reads reg as an argument
+            if (line.isCall())
+            {
+                if (IsArgumentRegister(reg))
+                {
+                    return false;
+                }
+                continue;
+            }
+            if (line.definedRegister() == reg)
+            {
+                return true;
+            }
+            if (line.isConditionalBranch())
+            {
+                if (!IsDeadAtLabel(code, line.target(), reg, visited))
+                {
+                    return false;
+                }
+                continue;
+            }
+            if (line.opcode == "j")
+            {
+                return IsDeadAtLabel(code, line.target(), reg, visited);
+            }
+            if (line.isJump())
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // sw x, m; lw y, m  ->  sw x, m; mv y, x
+    bool ForwardStoreToLoad(std::vector<AssemblyLine> &code, size_t i)
+    {
+        static const std::map<std::string, std::pair<std::string, std::string>> forwardable = {
+            {"sw", {"lw", "mv"}},
+            {"fsw", {"flw", "fmv.s"}},
+            {"fsd", {"fld", "fmv.d"}},
+        };
+        auto pair = forwardable.find(code[i].opcode);
+        if (pair == forwardable.end() || !FollowedInBlock(code, i))
+        {
+            return false;
+        }
+        AssemblyLine &load = code[i + 1];
+        if (load.opcode != pair->second.first || load.operands.size() != 2 || code[i].operands.size() != 2 || load.operands[1] != code[i].operands[1])
+        {
+            return false;
+        }
+        const std::string &stored = code[i].operands[0];
+        if (load.operands[0] == stored)
+        {
+            code.erase(code.begin() + i + 1);
+        }
+        else
+        {
+            load = MakeInstruction(pair->second.second, {load.operands[0], stored});
+        }
+        return true;
+    }
+
+    // sw x, m; sw y, m  ->  sw y, m
+    bool RemoveOverwrittenStore(std::vector<AssemblyLine> &code, size_t i)
+    {
+        if (!code[i].isStore() || !FollowedInBlock(code, i))
+        {
+            return false;
+        }
+        const AssemblyLine &next = code[i + 1];
+        if (next.opcode != code[i].opcode || next.operands.size() != 2 || code[i].operands.size() != 2 || next.operands[1] != code[i].operands[1])
+        {
+            return false;
+        }
+        code.erase(code.begin() + i);
+        return true;
+    }
+
+    // slt x, a, b; andi y, x, 0xff  ->  slt y, a, b
+    // The comparison result is already 0 or 1, so the mask changes nothing
+    bool RemoveBooleanMask(std::vector<AssemblyLine> &code, size_t i)
+    {
+        static const std::set<std::string> booleans = {"slt", "sltu", "slti", "sltiu", "seqz", "snez", "feq.s", "flt.s", "fle.s", "feq.d", "flt.d", "fle.d"};
+        if (!booleans.count(code[i].opcode) || !FollowedInBlock(code, i))
+        {
+            return false;
+        }
+        const AssemblyLine &mask = code[i + 1];
+        int immediate;
+        std::string result = code[i].definedRegister();
+        if (mask.opcode != "andi" || mask.operands.size() != 3 || mask.operands[1] != result || !IsImmediate(mask.operands[2], immediate) || (immediate & 1) == 0)
+        {
+            return false;
+        }
+        std::string destination = mask.operands[0];
+        if (destination == result || IsDeadAfter(code, i + 1, result))
+        {
+            code[i].operands[0] = destination;
+            code.erase(code.begin() + i + 1);
+        }
+        else
+        {
+            code[i + 1] = MakeInstruction("mv", {destination, result});
+        }
+        return true;
+    }
+
+    // mv x, x
+    bool RemoveSelfMove(std::vector<AssemblyLine> &code, size_t i)
+    {
+        const AssemblyLine &line = code[i];
+        if ((line.opcode != "mv" && line.opcode != "fmv.s" && line.opcode != "fmv.d") || line.operands.size() != 2 || line.operands[0] != line.operands[1])
+        {
+            return false;
+        }
+        code.erase(code.begin() + i);
+        return true;
+    }
+
+    // j L; L:  ->  L:
+    bool RemoveJumpToNext(std::vector<AssemblyLine> &code, size_t i)
+    {
+        if (code[i].opcode != "j")
+        {
+            return false;
+        }
+        for (size_t next = i + 1; next < code.size() && code[next].isLabel(); next++)
+        {
+            if (code[next].label == code[i].target())
+            {
+                code.erase(code.begin() + i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // beq a, b, L1; j L2; L1:  ->  bne a, b, L2; L1:
+    bool InvertBranchOverJump(std::vector<AssemblyLine> &code, size_t i)
+    {
+        std::string inverted = InvertedBranch(code[i].opcode);
+        if (inverted.empty() || i + 2 >= code.size() || code[i + 1].opcode != "j")
+        {
+            return false;
+        }
+        for (size_t next = i + 2; next < code.size() && code[next].isLabel(); next++)
+        {
+            if (code[next].label == code[i].target())
+            {
+                code[i].opcode = inverted;
+                code[i].setTarget(code[i + 1].target());
+                code.erase(code.begin() + i + 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // li t, c; add x, y, t  ->  addi x, y, c
+    bool FoldImmediate(std::vector<AssemblyLine> &code, size_t i)
+    {
+        // Register-register instruction: {immediate form, commutative, shift}
+        struct ImmediateForm
+        {
+            std::string opcode;
+            bool commutative;
+            bool shift;
+        };
+        static const std::map<std::string, ImmediateForm> forms = {
+            {"add", {"addi", true, false}}, {"sub", {"addi", false, false}},
+            {"and", {"andi", true, false}}, {"or", {"ori", true, false}}, {"xor", {"xori", true, false}},
+            {"slt", {"slti", false, false}}, {"sltu", {"sltiu", false, false}},
+            {"sll", {"slli", false, true}}, {"srl", {"srli", false, true}}, {"sra", {"srai", false, true}},
+        };
+        int constant;
+        if (code[i].opcode != "li" || code[i].operands.size() != 2 || !IsImmediate(code[i].operands[1], constant) || !FollowedInBlock(code, i))
+        {
+            return false;
+        }
+        AssemblyLine &operation = code[i + 1];
+        auto form = forms.find(operation.opcode);
+        if (form == forms.end() || operation.operands.size() != 3)
+        {
+            return false;
+        }
+        const std::string &temporary = code[i].operands[0];
+        std::string other;
+        if (operation.operands[2] == temporary && operation.operands[1] != temporary)
+        {
+            other = operation.operands[1];
+        }
+        else if (form->second.commutative && operation.operands[1] == temporary && operation.operands[2] != temporary)
+        {
+            other = operation.operands[2];
+        }
+        else
+        {
+            return false;
+        }
+        if (operation.opcode == "sub")
+        {
+            if (constant == INT32_MIN)
+            {
+                return false;
+            }
+            constant = -constant;
+        }
+        if (form->second.shift ? (constant < 0 || constant > 31) : !FitsImmediate(constant))
+        {
+            return false;
+        }
+        if (operation.operands[0] != temporary && !IsDeadAfter(code, i + 1, temporary))
+        {
+            return false;
+        }
+        operation = MakeInstruction(form->second.opcode, {operation.operands[0], other, std::to_string(constant)});
+        code.erase(code.begin() + i);
+        return true;
+    }
+
+    // lw x, m; li x, 0  ->  li x, 0
+    // A register written again before it is read did not need the first value
+    bool RemoveDeadWrite(std::vector<AssemblyLine> &code, size_t i)
+    {
+        std::string written = code[i].definedRegister();
+        if (written.empty() || written == "zero" || code[i].isCall() || !IsDeadAfter(code, i, written))
+        {
+            return false;
+        }
+        code.erase(code.begin() + i);
+        return true;
+    }
+
+    const PeepholeRule peepholeRules[] = {
+        {"forward-store-to-load", ForwardStoreToLoad},
+        {"remove-overwritten-store", RemoveOverwrittenStore},
+        {"remove-boolean-mask", RemoveBooleanMask},
+        {"remove-self-move", RemoveSelfMove},
+        {"remove-jump-to-next", RemoveJumpToNext},
+        {"invert-branch-over-jump", InvertBranchOverJump},
+        {"fold-immediate", FoldImmediate},
+        {"remove-dead-write", RemoveDeadWrite},
+    };
+}
+
+bool IsDeadAfter(const std::vector<AssemblyLine> &code, size_t i, const std::string &reg)
+{
+    std::set<std::string> visited;
+    return IsDeadFrom(code, i + 1, reg, visited);
+}
+
+int RunPeephole(std::vector<AssemblyLine> &code)
+{
+    int rewrites = 0;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t i = 0; i < code.size(); i++)
+        {
+            for (const auto &rule : peepholeRules)
+            {
+                if (i < code.size() && rule.apply(code, i))
+                {
+                    rewrites++;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return rewrites;
+}
@@ -0,0 +1,201 @@
+#include <profile.h>
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "block_layout.h"
+
+namespace
+{
+    // Each counter sits in an entry of a table the program writes out:
+    // function name, number of blocks, block and count
+    const int entrySize = 16;
+    const int countOffset = 12;
+
+    // Numbered on from the number of labels there are, so the names only
+    // depend on this file
+    std::string NewLabel(std::set<std::string> &labels)
+    {
+        size_t count = labels.size();
+        std::string label;
+        do
+        {
+            label = "LP" + std::to_string(++count);
+        } while (labels.count(label));
+        labels.insert(label);
+        return label;
+    }
+
+    // The counter is incremented through t0 and t1, which are saved on the
+    // stack around it, so no register changes
+    std::vector<AssemblyLine> Increment(const std::string &counter)
+    {
+        std::string high = "%hi(" + counter + ")";
+        std::string low = "%lo(" + counter + ")(t0)";
+        return {
+            MakeInstruction("addi", {"sp", "sp", "-16"}),
+            MakeInstruction("sw", {"t0", "0(sp)"}),
+            MakeInstruction("sw", {"t1", "4(sp)"}),
+            MakeInstruction("lui", {"t0", high}),
+            MakeInstruction("lw", {"t1", low}),
+            MakeInstruction("addi", {"t1", "t1", "1"}),
+            MakeInstruction("sw", {"t1", low}),
+            MakeInstruction("lw", {"t1", "4(sp)"}),
+            MakeInstruction("lw", {"t0", "0(sp)"}),
+            MakeInstruction("addi", {"sp", "sp", "16"}),
+        };
+    }
+
+    std::string Quote(const std::string &text)
+    {
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    // The counter table, and the code that writes it out: a constructor
+    // registers the dump with atexit, and the dump appends a line per
+    // counter to the profile with fprintf
+    void EmitRuntime(std::ostream &stream, const std::map<std::string, std::vector<size_t>> &functions, const std::string &table, const std::string &path, std::set<std::string> &labels)
+    {
+        std::string pathLabel = NewLabel(labels), modeLabel = NewLabel(labels), formatLabel = NewLabel(labels);
+        stream << ".section .rodata" << std::endl;
+        stream << pathLabel << ":" << std::endl << ".string " << Quote(path) << std::endl;
+        stream << modeLabel << ":" << std::endl << ".string \"a\"" << std::endl;
+        stream << formatLabel << ":" << std::endl << ".string \"%s %u %u %u\\n\"" << std::endl;
+        std::map<std::string, std::string> names;
+        for (auto &function : functions)
+        {
+            names[function.first] = NewLabel(labels);
+            stream << names[function.first] << ":" << std::endl << ".string " << Quote(function.first) << std::endl;
+        }
+
+        size_t entries = 0;
+        stream << ".data" << std::endl << ".align 2" << std::endl << table << ":" << std::endl;
+        for (auto &function : functions)
+        {
+            for (size_t block = 0; block < function.second.size(); block++, entries++)
+            {
+                stream << ".word " << names[function.first] << ", " << function.second.size() << ", " << block << ", 0" << std::endl;
+            }
+        }
+
+        std::string loop = NewLabel(labels), done = NewLabel(labels);
+        stream << ".section .init_array,\"aw\"" << std::endl << ".align 2" << std::endl << ".word __profile_init" << std::endl;
+        stream << ".text" << std::endl << ".align 2" << std::endl;
+        stream << "__profile_init:" << std::endl;
+        stream << "la a0, __profile_dump" << std::endl;
+        stream << "tail atexit" << std::endl;
+        stream << "__profile_dump:" << std::endl;
+        stream << "addi sp, sp, -16" << std::endl;
+        stream << "sw ra, 12(sp)" << std::endl;
+        stream << "sw s0, 8(sp)" << std::endl;
+        stream << "sw s1, 4(sp)" << std::endl;
+        stream << "sw s2, 0(sp)" << std::endl;
+        stream << "la a0, " << pathLabel << std::endl;
+        stream << "la a1, " << modeLabel << std::endl;
+        stream << "call fopen" << std::endl;
+        stream << "beqz a0, " << done << std::endl;
+        stream << "mv s0, a0" << std::endl;
+        stream << "la s1, " << table << std::endl;
+        stream << "li s2, " << entries << std::endl;
+        stream << loop << ":" << std::endl;
+        stream << "mv a0, s0" << std::endl;
+        stream << "la a1, " << formatLabel << std::endl;
+        stream << "lw a2, 0(s1)" << std::endl;
+        stream << "lw a3, 4(s1)" << std::endl;
+        stream << "lw a4, 8(s1)" << std::endl;
+        stream << "lw a5, " << countOffset << "(s1)" << std::endl;
+        stream << "call fprintf" << std::endl;
+        stream << "addi s1, s1, " << entrySize << std::endl;
+        stream << "addi s2, s2, -1" << std::endl;
+        stream << "bnez s2, " << loop << std::endl;
+        stream << "mv a0, s0" << std::endl;
+        stream << "call fclose" << std::endl;
+        stream << done << ":" << std::endl;
+        stream << "lw s2, 0(sp)" << std::endl;
+        stream << "lw s1, 4(sp)" << std::endl;
+        stream << "lw s0, 8(sp)" << std::endl;
+        stream << "lw ra, 12(sp)" << std::endl;
+        stream << "addi sp, sp, 16" << std::endl;
+        stream << "ret" << std::endl;
+    }
+}
+
+bool ReadProfile(const std::string &path, Profile &profile)
+{
+    std::ifstream input(path);
+    if (!input)
+    {
+        return false;
+    }
+    std::string function;
+    size_t blocks, block;
+    long long count;
+    while (input >> function >> blocks >> block >> count)
+    {
+        if (blocks == 0)
+        {
+            continue;
+        }
+        // A run of a different build of the function replaces the counts
+        std::vector<long long> &counts = profile.blockCounts[function];
+        if (counts.size() != blocks)
+        {
+            counts.assign(blocks, 0);
+        }
+        if (block < blocks)
+        {
+            counts[block] += count;
+        }
+    }
+    return true;
+}
+
+int RunProfileInstrumentation(std::vector<AssemblyLine> &code, const std::string &path)
+{
+    std::map<std::string, std::vector<size_t>> functions = FindBasicBlocks(code);
+    std::set<std::string> labels;
+    for (auto &line : code)
+    {
+        if (line.isLabel())
+        {
+            labels.insert(line.label);
+        }
+    }
+    std::string table = NewLabel(labels);
+
+    // Increments go in from the back, so the positions still hold
+    std::map<size_t, int> counters;
+    int entries = 0;
+    for (auto &function : functions)
+    {
+        for (size_t start : function.second)
+        {
+            counters[start] = entries++;
+        }
+    }
+    if (entries == 0)
+    {
+        return 0;
+    }
+    for (auto counter = counters.rbegin(); counter != counters.rend(); counter++)
+    {
+        std::vector<AssemblyLine> increment = Increment(table + "+" + std::to_string(counter->second * entrySize + countOffset));
+        code.insert(code.begin() + counter->first, increment.begin(), increment.end());
+    }
+
+    std::stringstream runtime;
+    EmitRuntime(runtime, functions, table, path, labels);
+    std::vector<AssemblyLine> lines = ParseAssembly(runtime);
+    code.insert(code.end(), lines.begin(), lines.end());
+    return entries;
+}
@@ -0,0 +1,319 @@
+#include <scheduler.h>
+
+#include <algorithm>
+#include <set>
+
+namespace
+{
+    // A dual-issue in-order core in the style of the SiFive U74: two integer
+    // pipes, one load/store pipe, a pipelined multiplier, an iterative
+    // divider and a pipelined FPU with an iterative divider
+    const PipelineModel pipelineModels[] = {
+        {
+            "dual-issue",
+            2,
+            {2, 1, 1, 1},
+            {
+                {1, INTEGER_UNIT, 1},   // INTEGER_OPERATION
+                {3, MEMORY_UNIT, 1},    // LOAD_OPERATION
+                {1, MEMORY_UNIT, 1},    // STORE_OPERATION
+                {3, MULTIPLY_UNIT, 1},  // MULTIPLY_OPERATION
+                {20, MULTIPLY_UNIT, 20}, // DIVIDE_OPERATION
+                {4, FLOAT_UNIT, 1},     // FLOAT_ADD_OPERATION
+                {5, FLOAT_UNIT, 1},     // FLOAT_MULTIPLY_OPERATION
+                {20, FLOAT_UNIT, 20},   // FLOAT_DIVIDE_OPERATION
+                {2, FLOAT_UNIT, 1},     // FLOAT_MOVE_OPERATION
+                {1, INTEGER_UNIT, 1},   // BRANCH_OPERATION
+            },
+        },
+        // A classic five-stage single-issue pipeline
+        {
+            "single-issue",
+            1,
+            {1, 1, 1, 1},
+            {
+                {1, INTEGER_UNIT, 1},
+                {2, MEMORY_UNIT, 1},
+                {1, MEMORY_UNIT, 1},
+                {3, MULTIPLY_UNIT, 1},
+                {34, MULTIPLY_UNIT, 34},
+                {3, FLOAT_UNIT, 1},
+                {4, FLOAT_UNIT, 1},
+                {20, FLOAT_UNIT, 20},
+                {1, FLOAT_UNIT, 1},
+                {1, INTEGER_UNIT, 1},
+            },
+        },
+    };
+
+    OperationClass ClassifyOperation(const AssemblyLine &line)
+    {
+        static const std::set<std::string> multiplies = {"mul", "mulh", "mulhu", "mulhsu"};
+        static const std::set<std::string> divides = {"div", "divu", "rem", "remu"};
+        const std::string &opcode = line.opcode;
+        if (line.isLoad())
+        {
+            return LOAD_OPERATION;
+        }
+        if (line.isStore())
+        {
+            return STORE_OPERATION;
+        }
+        if (line.endsBlock())
+        {
+            return BRANCH_OPERATION;
+        }
+        if (multiplies.count(opcode))
+        {
+            return MULTIPLY_OPERATION;
+        }
+        if (divides.count(opcode))
+        {
+            return DIVIDE_OPERATION;
+        }
+        if (opcode.rfind("fmul", 0) == 0 || opcode.rfind("fmadd", 0) == 0 || opcode.rfind("fmsub", 0) == 0)
+        {
+            return FLOAT_MULTIPLY_OPERATION;
+        }
+        if (opcode.rfind("fdiv", 0) == 0 || opcode.rfind("fsqrt", 0) == 0)
+        {
+            return FLOAT_DIVIDE_OPERATION;
+        }
+        if (opcode.rfind("fmv", 0) == 0 || opcode.rfind("fsgnj", 0) == 0)
+        {
+            return FLOAT_MOVE_OPERATION;
+        }
+        if (opcode[0] == 'f')
+        {
+            return FLOAT_ADD_OPERATION;
+        }
+        return INTEGER_OPERATION;
+    }
+
+    int AccessSize(const AssemblyLine &line)
+    {
+        const std::string &opcode = line.opcode;
+        if (opcode == "sb" || opcode == "lb" || opcode == "lbu")
+        {
+            return 1;
+        }
+        if (opcode == "sh" || opcode == "lh" || opcode == "lhu")
+        {
+            return 2;
+        }
+        if (opcode == "fsd" || opcode == "fld")
+        {
+            return 8;
+        }
+        return 4;
+    }
+
+    // Whether two memory accesses in the same block can touch the same bytes.
+    // Accesses off the same base register are told apart by their offsets, as
+    // long as the base is not written in between.
+    bool MayAlias(const std::vector<AssemblyLine> &code, size_t first, size_t second)
+    {
+        std::string firstOffset, firstBase, secondOffset, secondBase;
+        if (!SplitMemoryOperand(code[first].operands.back(), firstOffset, firstBase)
+            || !SplitMemoryOperand(code[second].operands.back(), secondOffset, secondBase) || firstBase != secondBase)
+        {
+            return true;
+        }
+        for (size_t between = first + 1; between < second; between++)
+        {
+            if (code[between].definedRegister() == firstBase)
+            {
+                return true;
+            }
+        }
+        int firstStart, secondStart;
+        try
+        {
+            firstStart = firstOffset.empty() ? 0 : std::stoi(firstOffset);
+            secondStart = secondOffset.empty() ? 0 : std::stoi(secondOffset);
+        }
+        catch (...)
+        {
+            return true;
+        }
+        return firstStart < secondStart + AccessSize(code[second]) && secondStart < firstStart + AccessSize(code[first]);
+    }
+
+    struct Dependence
+    {
+        size_t successor;
+        int latency;
+    };
+
+    // List scheduling of code[begin, end), which has no labels and no control
+    // flow except possibly a final branch. Each cycle the ready instructions
+    // with the longest latency path to the end of the block issue first.
+    int ScheduleBlock(std::vector<AssemblyLine> &code, size_t begin, size_t end, const PipelineModel &model)
+    {
+        size_t last = end;
+        if (code[end - 1].endsBlock())
+        {
+            last = end - 1; // The branch stays at the end
+        }
+        size_t count = last - begin;
+        if (count < 3)
+        {
+            return 0;
+        }
+
+        std::vector<std::vector<Dependence>> successors(count);
+        std::vector<int> predecessors(count, 0);
+        std::vector<OperationClass> classes(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            classes[i] = ClassifyOperation(code[begin + i]);
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            const AssemblyLine &earlier = code[begin + i];
+            std::string defined = earlier.definedRegister();
+            std::vector<std::string> used = earlier.usedRegisters();
+            for (size_t j = i + 1; j < count; j++)
+            {
+                const AssemblyLine &later = code[begin + j];
+                int latency = -1;
+                if (!defined.empty() && later.uses(defined))
+                {
+                    latency = model.timing[classes[i]].latency;
+                }
+                else if (!defined.empty() && later.definedRegister() == defined)
+                {
+                    latency = 1;
+                }
+                else if (std::find(used.begin(), used.end(), later.definedRegister()) != used.end())
+                {
+                    latency = 0;
+                }
+                else if ((earlier.isStore() && (later.isLoad() || later.isStore())) || (earlier.isLoad() && later.isStore()))
+                {
+                    if (MayAlias(code, begin + i, begin + j))
+                    {
+                        latency = earlier.isStore() && later.isLoad() ? 1 : 0;
+                    }
+                }
+                if (latency >= 0)
+                {
+                    successors[i].push_back({j, latency});
+                    predecessors[j]++;
+                }
+            }
+        }
+
+        // Longest latency path from each instruction to the end of the block
+        std::vector<int> height(count, 0);
+        for (size_t i = count; i-- > 0;)
+        {
+            height[i] = model.timing[classes[i]].latency;
+            for (auto &dependence : successors[i])
+            {
+                height[i] = std::max(height[i], dependence.latency + height[dependence.successor]);
+            }
+        }
+
+        std::vector<int> earliest(count, 0);
+        std::vector<bool> scheduled(count, false);
+        std::vector<std::vector<int>> unitBusyUntil(FUNCTIONAL_UNITS);
+        for (int unit = 0; unit < FUNCTIONAL_UNITS; unit++)
+        {
+            unitBusyUntil[unit].assign(model.unitCount[unit], 0);
+        }
+        std::vector<size_t> order;
+        int cycle = 0;
+        while (order.size() < count)
+        {
+            int issued = 0;
+            while (issued < model.issueWidth)
+            {
+                size_t best = count;
+                int *bestUnit = nullptr;
+                for (size_t i = 0; i < count; i++)
+                {
+                    if (scheduled[i] || predecessors[i] > 0 || earliest[i] > cycle)
+                    {
+                        continue;
+                    }
+                    const OperationTiming &timing = model.timing[classes[i]];
+                    auto unit = std::min_element(unitBusyUntil[timing.unit].begin(), unitBusyUntil[timing.unit].end());
+                    if (unit == unitBusyUntil[timing.unit].end() || *unit > cycle)
+                    {
+                        continue;
+                    }
+                    if (best == count || height[i] > height[best])
+                    {
+                        best = i;
+                        bestUnit = &*unit;
+                    }
+                }
+                if (best == count)
+                {
+                    break;
+                }
+                scheduled[best] = true;
+                order.push_back(best);
+                *bestUnit = cycle + model.timing[classes[best]].occupancy;
+                for (auto &dependence : successors[best])
+                {
+                    predecessors[dependence.successor]--;
+                    earliest[dependence.successor] = std::max(earliest[dependence.successor], cycle + dependence.latency);
+                }
+                issued++;
+            }
+            cycle++;
+        }
+
+        std::vector<AssemblyLine> block;
+        int moved = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            block.push_back(code[begin + order[i]]);
+            moved += order[i] != i;
+        }
+        std::copy(block.begin(), block.end(), code.begin() + begin);
+        return moved;
+    }
+}
+
+const PipelineModel *FindPipelineModel(const std::string &name)
+{
+    for (const auto &model : pipelineModels)
+    {
+        if (name == model.name)
+        {
+            return &model;
+        }
+    }
+    return nullptr;
+}
+
+int RunScheduler(std::vector<AssemblyLine> &code, const PipelineModel &model)
+{
+    int moved = 0;
+    size_t begin = 0;
+    while (begin < code.size())
+    {
+        if (!code[begin].isInstruction())
+        {
+            begin++;
+            continue;
+        }
+        // Calls end a block too: values in memory and in caller-saved
+        // registers change across them
+        size_t end = begin;
+        while (end < code.size() && code[end].isInstruction())
+        {
+            end++;
+            if (code[end - 1].endsBlock())
+            {
+                break;
+            }
+        }
+        moved += ScheduleBlock(code, begin, end, model);
+        begin = end;
+    }
+    return moved;
+}
@@ -0,0 +1,258 @@
+#include <statistics.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+namespace
+{
+    // Heap allocations made by this thread, through any form of operator new
+    thread_local long long allocations = 0;
+    thread_local long long allocatedBytes = 0;
+
+    void *Allocate(std::size_t size)
+    {
+        allocations++;
+        allocatedBytes += size;
+        void *pointer = std::malloc(size == 0 ? 1 : size);
+        if (pointer == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+
+    std::string Quote(const std::string &text)
+    {
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                quoted += '\\';
+                quoted += c;
+            }
+            else if ((unsigned char)c < 0x20)
+            {
+                std::ostringstream escape;
+                escape << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c;
+                quoted += escape.str();
+            }
+            else
+            {
+                quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+
+    PhaseTiming Total(const CompilationStatistics &statistics)
+    {
+        PhaseTiming total;
+        total.name = "total";
+        for (auto &phase : statistics.phases)
+        {
+            total.add(phase);
+        }
+        return total;
+    }
+
+    void WriteCounters(std::ostream &output, const std::map<std::string, long long> &counters)
+    {
+        bool first = true;
+        output << "{";
+        for (auto &counter : counters)
+        {
+            output << (first ? "" : ", ") << Quote(counter.first) << ": " << counter.second;
+            first = false;
+        }
+        output << "}";
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    return Allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return Allocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+ResourceSnapshot TakeSnapshot()
+{
+    ResourceSnapshot snapshot;
+    snapshot.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    timespec cpu;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+    snapshot.cpuSeconds = cpu.tv_sec + cpu.tv_nsec * 1e-9;
+    snapshot.allocations = allocations;
+    snapshot.allocatedBytes = allocatedBytes;
+    return snapshot;
+}
+
+void PhaseTiming::add(const ResourceSnapshot &start, const ResourceSnapshot &end)
+{
+    wallSeconds += end.wallSeconds - start.wallSeconds;
+    cpuSeconds += end.cpuSeconds - start.cpuSeconds;
+    allocations += end.allocations - start.allocations;
+    allocatedBytes += end.allocatedBytes - start.allocatedBytes;
+}
+
+void PhaseTiming::add(const PhaseTiming &other)
+{
+    wallSeconds += other.wallSeconds;
+    cpuSeconds += other.cpuSeconds;
+    allocations += other.allocations;
+    allocatedBytes += other.allocatedBytes;
+}
+
+void PhaseTiming::subtract(const PhaseTiming &other)
+{
+    wallSeconds -= other.wallSeconds;
+    cpuSeconds -= other.cpuSeconds;
+    allocations -= other.allocations;
+    allocatedBytes -= other.allocatedBytes;
+}
+
+PhaseTiming &CompilationStatistics::phase(const std::string &name)
+{
+    for (auto &phase : phases)
+    {
+        if (phase.name == name)
+        {
+            return phase;
+        }
+    }
+    phases.push_back(PhaseTiming());
+    phases.back().name = name;
+    return phases.back();
+}
+
+void CompilationStatistics::countOpcodes(const std::vector<AssemblyLine> &code)
+{
+    for (auto &line : code)
+    {
+        if (line.isInstruction())
+        {
+            opcodes[line.opcode]++;
+        }
+    }
+}
+
+void CompilationStatistics::add(const CompilationStatistics &other)
+{
+    for (auto &phase : other.phases)
+    {
+        this->phase(phase.name).add(phase);
+    }
+    for (auto &counter : other.counters)
+    {
+        counters[counter.first] += counter.second;
+    }
+    for (auto &opcode : other.opcodes)
+    {
+        opcodes[opcode.first] += opcode.second;
+    }
+}
+
+PhaseTimer::PhaseTimer(CompilationStatistics &statistics, const std::string &name)
+    : statistics(statistics), name(name)
+{
+    if (statistics.timing)
+    {
+        start = TakeSnapshot();
+    }
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    if (statistics.timing)
+    {
+        statistics.phase(name).add(start, TakeSnapshot());
+    }
+}
+
+void WriteTimeReport(std::ostream &output, const CompilationStatistics &statistics)
+{
+    std::vector<PhaseTiming> rows = statistics.phases;
+    rows.push_back(Total(statistics));
+    output << "Time report:" << std::endl;
+    output << std::left << std::setw(26) << " phase" << std::right
+           << std::setw(12) << "wall (s)" << std::setw(12) << "cpu (s)"
+           << std::setw(14) << "allocations" << std::setw(16) << "allocated (kB)" << std::endl;
+    for (auto &row : rows)
+    {
+        output << std::left << std::setw(26) << " " + row.name << std::right << std::fixed << std::setprecision(6)
+               << std::setw(12) << row.wallSeconds << std::setw(12) << row.cpuSeconds
+               << std::setw(14) << row.allocations << std::setw(16) << row.allocatedBytes / 1024 << std::endl;
+    }
+    output.unsetf(std::ios::floatfield);
+}
+
+void WriteStatistics(std::ostream &output, const CompilationStatistics &statistics)
+{
+    output << "Statistics:" << std::endl;
+    for (auto &counter : statistics.counters)
+    {
+        output << std::left << std::setw(32) << " " + counter.first << std::right << std::setw(10) << counter.second << std::endl;
+    }
+    long long instructions = 0;
+    for (auto &opcode : statistics.opcodes)
+    {
+        instructions += opcode.second;
+    }
+    output << "Instructions by opcode (" << instructions << " in total):" << std::endl;
+    for (auto &opcode : statistics.opcodes)
+    {
+        output << std::left << std::setw(32) << " " + opcode.first << std::right << std::setw(10) << opcode.second << std::endl;
+    }
+}
+
+void WriteStatisticsJson(std::ostream &output, const CompilationStatistics &statistics, const std::string &source)
+{
+    std::vector<PhaseTiming> rows = statistics.phases;
+    rows.push_back(Total(statistics));
+    output << "{" << std::endl;
+    output << "  \"source\": " << Quote(source) << "," << std::endl;
+    output << "  \"time_report\": [";
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        output << (i == 0 ? "" : ",") << std::endl;
+        output << "    {\"phase\": " << Quote(rows[i].name)
+               << ", \"wall_seconds\": " << rows[i].wallSeconds
+               << ", \"cpu_seconds\": " << rows[i].cpuSeconds
+               << ", \"allocations\": " << rows[i].allocations
+               << ", \"allocated_bytes\": " << rows[i].allocatedBytes << "}";
+    }
+    output << std::endl << "  ]," << std::endl;
+    output << "  \"statistics\": ";
+    WriteCounters(output, statistics.counters);
+    output << "," << std::endl << "  \"opcodes\": ";
+    WriteCounters(output, statistics.opcodes);
+    output << std::endl << "}" << std::endl;
+}
@@ -0,0 +1,143 @@
+#include <task_graph.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    // A thread's ready tasks. The owner works at the back, thieves at the
+    // front, so they only meet on the last task.
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    class TaskGraph
+    {
+    public:
+        TaskGraph(const std::vector<std::vector<size_t>> &dependencies, size_t threads, const std::function<void(size_t)> &run)
+            : run(run), dependents(dependencies.size()), waiting(dependencies.size()), queues(threads)
+        {
+            for (auto &queue : queues)
+            {
+                queue = std::make_unique<WorkQueue>();
+            }
+            size_t ready = 0;
+            for (size_t task = 0; task < dependencies.size(); task++)
+            {
+                waiting[task] = dependencies[task].size();
+                for (size_t dependency : dependencies[task])
+                {
+                    dependents[dependency].push_back(task);
+                }
+                if (dependencies[task].empty())
+                {
+                    queues[ready++ % threads]->tasks.push_back(task);
+                }
+            }
+            pending = (long)ready;
+        }
+
+        void work(size_t self)
+        {
+            size_t task;
+            while (take(self, task))
+            {
+                run(task);
+                for (size_t dependent : dependents[task])
+                {
+                    if (--waiting[dependent] == 0)
+                    {
+                        push(self, dependent);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(idleMutex);
+                if (++finished == dependents.size())
+                {
+                    wake.notify_all();
+                }
+            }
+        }
+
+    private:
+        const std::function<void(size_t)> &run;
+        std::vector<std::vector<size_t>> dependents;
+        std::vector<std::atomic<size_t>> waiting; // Dependencies each task is still waiting for
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+
+        // Threads with nothing to take sleep until a task is pushed or the
+        // last one finishes
+        std::mutex idleMutex;
+        std::condition_variable wake;
+        long pending = 0; // Tasks in a queue, for a moment off by one around a push
+        size_t finished = 0;
+
+        void push(size_t self, size_t task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(queues[self]->mutex);
+                queues[self]->tasks.push_back(task);
+            }
+            std::lock_guard<std::mutex> lock(idleMutex);
+            pending++;
+            wake.notify_one();
+        }
+
+        bool pop(WorkQueue &queue, bool own, size_t &task)
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                return false;
+            }
+            task = own ? queue.tasks.back() : queue.tasks.front();
+            own ? queue.tasks.pop_back() : queue.tasks.pop_front();
+            return true;
+        }
+
+        // Returns false once every task has finished
+        bool take(size_t self, size_t &task)
+        {
+            while (true)
+            {
+                for (size_t k = 0; k < queues.size(); k++)
+                {
+                    if (pop(*queues[(self + k) % queues.size()], k == 0, task))
+                    {
+                        std::lock_guard<std::mutex> lock(idleMutex);
+                        pending--;
+                        return true;
+                    }
+                }
+                std::unique_lock<std::mutex> lock(idleMutex);
+                wake.wait(lock, [&] { return pending > 0 || finished == dependents.size(); });
+                if (finished == dependents.size())
+                {
+                    return false;
+                }
+            }
+        }
+    };
+}
+
+void RunTaskGraph(const std::vector<std::vector<size_t>> &dependencies, size_t threads, const std::function<void(size_t)> &run)
+{
+    threads = std::max<size_t>(1, std::min(threads, dependencies.size()));
+    TaskGraph graph(dependencies, threads, run);
+    std::vector<std::thread> pool;
+    for (size_t k = 1; k < threads; k++)
+    {
+        pool.emplace_back([&graph, k] { graph.work(k); });
+    }
+    graph.work(0);
+    for (auto &thread : pool)
+    {
+        thread.join();
+    }
+}